@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "mock-compositor.hpp"
+#include "towl/compositor.hpp"
+#include "towl/display.hpp"
+#include "towl/output.hpp"
+#include "towl/seat.hpp"
+#include "towl/shm-swapchain.hpp"
+#include "towl/shm.hpp"
+#include "towl/static-registry.hpp"
+#include "towl/xdg-wm-base.hpp"
+#include "macros/assert.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Counter : towl::KeyboardCallbacks, towl::PointerCallbacks, towl::TouchCallbacks, towl::OutputCallbacks {
+    uint64_t pointer_motion = 0;
+    uint64_t keyboard_key   = 0;
+    uint64_t touch_motion   = 0;
+    uint64_t output_mode    = 0;
+
+    auto on_wl_pointer_motion(double /*x*/, double /*y*/) -> void override {
+        pointer_motion += 1;
+    }
+
+    auto on_wl_keyboard_key(uint32_t /*key*/, uint32_t /*state*/) -> void override {
+        keyboard_key += 1;
+    }
+
+    auto on_wl_touch_motion(uint32_t /*id*/, double /*x*/, double /*y*/) -> void override {
+        touch_motion += 1;
+    }
+
+    auto on_wl_output_mode(wl_output* /*output*/, uint32_t /*flags*/, int32_t /*width*/, int32_t /*height*/, int32_t /*refresh*/) -> void override {
+        output_mode += 1;
+    }
+};
+
+using Registry = towl::StaticRegistry<towl::CompositorBinder, towl::ShmBinder, towl::SeatBinder, towl::OutputBinder, towl::XDGWMBaseBinder>;
+
+struct Client {
+    towl::Display display;
+    Registry      registry;
+
+    Client(MockCompositor& mock, Counter& counter)
+        : display(mock.connect()),
+          registry(display.get_registry(),
+                   towl::CompositorBinder(4),
+                   towl::ShmBinder(1),
+                   towl::SeatBinder(7, &counter, &counter, &counter),
+                   towl::OutputBinder(4, &counter),
+                   towl::XDGWMBaseBinder(2)) {
+        ASSERT(display.roundtrip()); // globals
+        ASSERT(display.roundtrip()); // seat capabilities and output state
+    }
+};
+
+auto elapsed_us(const Clock::time_point begin) -> double {
+    return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+}
+
+auto percentile(std::vector<double>& samples, const double p) -> double {
+    const auto index = size_t(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+template <class Send>
+auto bench_dispatch(const char* const name, Client& client, const uint64_t& counter, const Send send) -> void {
+    constexpr auto total = uint64_t(200000);
+    constexpr auto chunk = uint32_t(64); // keep each batch well below the socket buffer size
+
+    const auto begin = Clock::now();
+    const auto base  = counter;
+    for(auto sent = uint64_t(0); sent < total; sent += chunk) {
+        send(chunk);
+        while(counter - base < sent + chunk) {
+            ASSERT(client.display.dispatch());
+        }
+    }
+    const auto us = elapsed_us(begin);
+    std::printf("dispatch %-16s %12.0f events/s %8.3f us/event\n", name, total / us * 1e6, us / total);
+}
+
+auto bench_roundtrip(Client& client) -> void {
+    constexpr auto count = 10000;
+
+    auto samples = std::vector<double>();
+    samples.reserve(count);
+    for(auto i = 0; i < count; i += 1) {
+        const auto begin = Clock::now();
+        ASSERT(client.display.roundtrip());
+        samples.push_back(elapsed_us(begin));
+    }
+    const auto p50 = percentile(samples, 0.50);
+    const auto p99 = percentile(samples, 0.99);
+    const auto max = *std::ranges::max_element(samples);
+    std::printf("roundtrip                 p50 %.1f us p99 %.1f us max %.1f us\n", p50, p99, max);
+}
+
+auto bench_startup(MockCompositor& mock) -> void {
+    constexpr auto count = 500;
+
+    auto counter = Counter();
+    auto samples = std::vector<double>();
+    samples.reserve(count);
+    for(auto i = 0; i < count; i += 1) {
+        const auto begin  = Clock::now();
+        const auto client = Client(mock, counter);
+        samples.push_back(elapsed_us(begin));
+    }
+    const auto p50 = percentile(samples, 0.50);
+    const auto p99 = percentile(samples, 0.99);
+    std::printf("registry startup          p50 %.1f us p99 %.1f us\n", p50, p99);
+}
+
+auto bench_commit(MockCompositor& mock, Client& client) -> void {
+    constexpr auto count  = 20000;
+    constexpr auto width  = 256;
+    constexpr auto height = 256;
+
+    const auto compositor = client.registry.get<towl::CompositorBinder>();
+    const auto wm_base    = client.registry.get<towl::XDGWMBaseBinder>();
+    const auto shm        = client.registry.get<towl::ShmBinder>();
+    ASSERT(compositor != nullptr && wm_base != nullptr && shm != nullptr);
+
+    auto surface_callbacks     = towl::SurfaceCallbacks();
+    auto surface               = compositor->create_surface();
+    auto xdg_surface_callbacks = towl::XDGSurfaceCallbacks();
+    auto xdg_surface           = wm_base->create_xdg_surface(surface);
+    auto toplevel_callbacks    = towl::XDGToplevelCallbacks();
+    auto& toplevel             = xdg_surface.create_xdg_toplevel();
+    surface.init(&surface_callbacks);
+    xdg_surface.init(&xdg_surface_callbacks);
+    toplevel.init(&toplevel_callbacks);
+    surface.commit();
+    ASSERT(client.display.roundtrip());
+
+    auto swapchain = towl::ShmSwapchain();
+    ASSERT(swapchain.init(*shm, 3, width, height, WL_SHM_FORMAT_ARGB8888));
+
+    const auto base  = mock.get_commit_count();
+    const auto begin = Clock::now();
+    for(auto i = 0; i < count; i += 1) {
+        auto buffer = swapchain.acquire();
+        while(buffer == nullptr) {
+            ASSERT(client.display.dispatch());
+            buffer = swapchain.acquire();
+        }
+        surface.attach(buffer->native(), 0, 0);
+        surface.damage(0, 0, width, height);
+        surface.commit();
+        client.display.flush();
+    }
+    ASSERT(client.display.roundtrip());
+    const auto us = elapsed_us(begin);
+    ASSERT(mock.get_commit_count() - base == count);
+    std::printf("commit %dx%d           %12.0f commits/s\n", width, height, count / us * 1e6);
+}
+} // namespace
+
+auto main() -> int {
+    auto mock    = MockCompositor();
+    auto counter = Counter();
+    auto client  = Client(mock, counter);
+
+    bench_dispatch("pointer.motion", client, counter.pointer_motion, [&mock](uint32_t n) { mock.send_pointer_motion(n); });
+    bench_dispatch("keyboard.key", client, counter.keyboard_key, [&mock](uint32_t n) { mock.send_keyboard_key(n); });
+    bench_dispatch("touch.motion", client, counter.touch_motion, [&mock](uint32_t n) { mock.send_touch_motion(n); });
+    bench_dispatch("output.mode", client, counter.output_mode, [&mock](uint32_t n) { mock.send_output_mode(n); });
+    bench_roundtrip(client);
+    bench_startup(mock);
+    bench_commit(mock, client);
+    return 0;
+}
@@ -0,0 +1,448 @@
+#include <atomic>
+#include <bit>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <wayland-server.h>
+#include <xdg-shell-server.h>
+
+#define namespace namespace_
+#include <wlr-layer-shell-unstable-v1-server.h>
+#undef namespace
+
+#include "macros/assert.hpp"
+#include "mock-compositor.hpp"
+
+// requests towl never sends are left unimplemented
+
+namespace {
+struct SurfaceState {
+    MockCompositor::Server*   server;
+    wl_resource*              pending_buffer = nullptr;
+    std::vector<wl_resource*> frames;
+    wl_resource*              xdg_surface   = nullptr;
+    wl_resource*              xdg_toplevel  = nullptr;
+    wl_resource*              layer_surface = nullptr;
+    bool                      configured    = false;
+};
+
+auto destroy_resource(wl_client* /*client*/, wl_resource* const resource) -> void {
+    wl_resource_destroy(resource);
+}
+
+auto now_ms() -> uint32_t {
+    auto ts = timespec();
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+} // namespace
+
+struct MockCompositor::Server {
+    wl_display*                        display;
+    int                                task_fd;
+    std::mutex                         task_lock;
+    std::vector<std::function<void()>> tasks;
+    std::thread                        thread;
+    std::atomic_uint64_t               commits = 0;
+
+    std::vector<wl_resource*> pointers;
+    std::vector<wl_resource*> keyboards;
+    std::vector<wl_resource*> touches;
+    std::vector<wl_resource*> outputs;
+
+    auto post(std::function<void()> task) -> void {
+        {
+            const auto lock = std::lock_guard(task_lock);
+            tasks.push_back(std::move(task));
+        }
+        const auto value = uint64_t(1);
+        ASSERT(write(task_fd, &value, sizeof(value)) == sizeof(value));
+    }
+
+    static auto on_task(const int fd, const uint32_t /*mask*/, void* const data) -> int {
+        auto& self  = *std::bit_cast<Server*>(data);
+        auto  value = uint64_t();
+        ASSERT(read(fd, &value, sizeof(value)) == sizeof(value));
+        auto tasks = std::vector<std::function<void()>>();
+        {
+            const auto lock = std::lock_guard(self.task_lock);
+            std::swap(tasks, self.tasks);
+        }
+        for(auto& task : tasks) {
+            task();
+        }
+        wl_display_flush_clients(self.display);
+        return 0;
+    }
+
+    // tracks a device resource until the client destroys it
+    static auto track(std::vector<wl_resource*>& list, wl_resource* const resource) -> void {
+        list.push_back(resource);
+        wl_resource_add_destroy_listener(resource, new Tracker{.listener = {.link = {}, .notify = Tracker::notify}, .list = &list});
+    }
+
+    struct Tracker {
+        wl_listener                listener;
+        std::vector<wl_resource*>* list;
+
+        static auto notify(wl_listener* const listener, void* const data) -> void {
+            auto& self = *wl_container_of(listener, static_cast<Tracker*>(nullptr), listener);
+            std::erase(*self.list, static_cast<wl_resource*>(data));
+            delete &self;
+        }
+    };
+
+    // wl_surface
+    static auto surface_attach(wl_client* /*client*/, wl_resource* const resource, wl_resource* const buffer, int32_t /*x*/, int32_t /*y*/) -> void {
+        auto& state          = *static_cast<SurfaceState*>(wl_resource_get_user_data(resource));
+        state.pending_buffer = buffer;
+    }
+
+    static auto surface_damage(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*x*/, int32_t /*y*/, int32_t /*width*/, int32_t /*height*/) -> void {}
+
+    static auto surface_frame(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      state    = *static_cast<SurfaceState*>(wl_resource_get_user_data(resource));
+        const auto callback = wl_resource_create(client, &wl_callback_interface, 1, id);
+        wl_resource_set_implementation(callback, nullptr, nullptr, nullptr);
+        state.frames.push_back(callback);
+    }
+
+    static auto surface_set_region(wl_client* /*client*/, wl_resource* /*resource*/, wl_resource* /*region*/) -> void {}
+
+    static auto surface_commit(wl_client* /*client*/, wl_resource* const resource) -> void {
+        auto& state = *static_cast<SurfaceState*>(wl_resource_get_user_data(resource));
+        state.server->commits += 1;
+        if(const auto buffer = std::exchange(state.pending_buffer, nullptr); buffer != nullptr) {
+            wl_buffer_send_release(buffer);
+        }
+        const auto time = now_ms();
+        for(const auto callback : std::exchange(state.frames, {})) {
+            wl_callback_send_done(callback, time);
+            wl_resource_destroy(callback);
+        }
+        if(state.configured) {
+            return;
+        }
+        const auto serial = wl_display_next_serial(state.server->display);
+        if(state.xdg_toplevel != nullptr) {
+            auto states = wl_array();
+            wl_array_init(&states);
+            xdg_toplevel_send_configure(state.xdg_toplevel, 0, 0, &states);
+            wl_array_release(&states);
+        }
+        if(state.xdg_surface != nullptr) {
+            xdg_surface_send_configure(state.xdg_surface, serial);
+            state.configured = true;
+        }
+        if(state.layer_surface != nullptr) {
+            zwlr_layer_surface_v1_send_configure(state.layer_surface, serial, 0, 0);
+            state.configured = true;
+        }
+    }
+
+    static auto surface_set_int(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*value*/) -> void {}
+
+    static auto surface_offset(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*x*/, int32_t /*y*/) -> void {}
+
+    static inline const struct wl_surface_interface surface_impl = {
+        .destroy              = destroy_resource,
+        .attach               = surface_attach,
+        .damage               = surface_damage,
+        .frame                = surface_frame,
+        .set_opaque_region    = surface_set_region,
+        .set_input_region     = surface_set_region,
+        .commit               = surface_commit,
+        .set_buffer_transform = surface_set_int,
+        .set_buffer_scale     = surface_set_int,
+        .damage_buffer        = surface_damage,
+        .offset               = surface_offset,
+    };
+
+    static auto destroy_surface(wl_resource* const resource) -> void {
+        delete static_cast<SurfaceState*>(wl_resource_get_user_data(resource));
+    }
+
+    // wl_region
+    static auto region_op(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*x*/, int32_t /*y*/, int32_t /*width*/, int32_t /*height*/) -> void {}
+
+    static inline const struct wl_region_interface region_impl = {
+        .destroy  = destroy_resource,
+        .add      = region_op,
+        .subtract = region_op,
+    };
+
+    // wl_compositor
+    static auto create_surface(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      self    = *static_cast<Server*>(wl_resource_get_user_data(resource));
+        const auto surface = wl_resource_create(client, &wl_surface_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(surface, &surface_impl, new SurfaceState{.server = &self}, destroy_surface);
+    }
+
+    static auto create_region(wl_client* const client, wl_resource* /*resource*/, const uint32_t id) -> void {
+        const auto region = wl_resource_create(client, &wl_region_interface, 1, id);
+        wl_resource_set_implementation(region, &region_impl, nullptr, nullptr);
+    }
+
+    static inline const struct wl_compositor_interface compositor_impl = {
+        .create_surface = create_surface,
+        .create_region  = create_region,
+    };
+
+    static auto bind_compositor(wl_client* const client, void* const data, const uint32_t version, const uint32_t id) -> void {
+        const auto resource = wl_resource_create(client, &wl_compositor_interface, version, id);
+        wl_resource_set_implementation(resource, &compositor_impl, data, nullptr);
+    }
+
+    // wl_seat
+    static auto set_cursor(wl_client* /*client*/, wl_resource* /*resource*/, uint32_t /*serial*/, wl_resource* /*surface*/, int32_t /*x*/, int32_t /*y*/) -> void {}
+
+    static inline const struct wl_pointer_interface pointer_impl = {
+        .set_cursor = set_cursor,
+        .release    = destroy_resource,
+    };
+
+    static inline const struct wl_keyboard_interface keyboard_impl = {
+        .release = destroy_resource,
+    };
+
+    static inline const struct wl_touch_interface touch_impl = {
+        .release = destroy_resource,
+    };
+
+    static auto get_pointer(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      self    = *static_cast<Server*>(wl_resource_get_user_data(resource));
+        const auto pointer = wl_resource_create(client, &wl_pointer_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(pointer, &pointer_impl, &self, nullptr);
+        track(self.pointers, pointer);
+    }
+
+    static auto get_keyboard(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      self     = *static_cast<Server*>(wl_resource_get_user_data(resource));
+        const auto keyboard = wl_resource_create(client, &wl_keyboard_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(keyboard, &keyboard_impl, &self, nullptr);
+        track(self.keyboards, keyboard);
+    }
+
+    static auto get_touch(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      self  = *static_cast<Server*>(wl_resource_get_user_data(resource));
+        const auto touch = wl_resource_create(client, &wl_touch_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(touch, &touch_impl, &self, nullptr);
+        track(self.touches, touch);
+    }
+
+    static inline const struct wl_seat_interface seat_impl = {
+        .get_pointer  = get_pointer,
+        .get_keyboard = get_keyboard,
+        .get_touch    = get_touch,
+        .release      = destroy_resource,
+    };
+
+    static auto bind_seat(wl_client* const client, void* const data, const uint32_t version, const uint32_t id) -> void {
+        const auto resource = wl_resource_create(client, &wl_seat_interface, version, id);
+        wl_resource_set_implementation(resource, &seat_impl, data, nullptr);
+        wl_seat_send_capabilities(resource, WL_SEAT_CAPABILITY_POINTER | WL_SEAT_CAPABILITY_KEYBOARD | WL_SEAT_CAPABILITY_TOUCH);
+        if(version >= WL_SEAT_NAME_SINCE_VERSION) {
+            wl_seat_send_name(resource, "mock-seat");
+        }
+    }
+
+    // wl_output
+    static inline const struct wl_output_interface output_impl = {
+        .release = destroy_resource,
+    };
+
+    static auto bind_output(wl_client* const client, void* const data, const uint32_t version, const uint32_t id) -> void {
+        auto&      self     = *static_cast<Server*>(data);
+        const auto resource = wl_resource_create(client, &wl_output_interface, version, id);
+        wl_resource_set_implementation(resource, &output_impl, data, nullptr);
+        track(self.outputs, resource);
+        wl_output_send_geometry(resource, 0, 0, 600, 340, WL_OUTPUT_SUBPIXEL_UNKNOWN, "towl", "mock", WL_OUTPUT_TRANSFORM_NORMAL);
+        wl_output_send_mode(resource, WL_OUTPUT_MODE_CURRENT, 1920, 1080, 60000);
+        if(version >= WL_OUTPUT_SCALE_SINCE_VERSION) {
+            wl_output_send_scale(resource, 1);
+        }
+        if(version >= WL_OUTPUT_NAME_SINCE_VERSION) {
+            wl_output_send_name(resource, "MOCK-1");
+        }
+        if(version >= WL_OUTPUT_DONE_SINCE_VERSION) {
+            wl_output_send_done(resource);
+        }
+    }
+
+    // xdg_wm_base
+    static auto set_title(wl_client* /*client*/, wl_resource* /*resource*/, const char* /*title*/) -> void {}
+
+    static inline const struct xdg_toplevel_interface toplevel_impl = {
+        .destroy   = destroy_resource,
+        .set_title = set_title,
+    };
+
+    static auto get_toplevel(wl_client* const client, wl_resource* const resource, const uint32_t id) -> void {
+        auto&      state    = *static_cast<SurfaceState*>(wl_resource_get_user_data(resource));
+        const auto toplevel = wl_resource_create(client, &xdg_toplevel_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(toplevel, &toplevel_impl, nullptr, nullptr);
+        state.xdg_toplevel = toplevel;
+    }
+
+    static auto ack_configure(wl_client* /*client*/, wl_resource* /*resource*/, uint32_t /*serial*/) -> void {}
+
+    static inline const struct xdg_surface_interface xdg_surface_impl = {
+        .destroy       = destroy_resource,
+        .get_toplevel  = get_toplevel,
+        .ack_configure = ack_configure,
+    };
+
+    static auto get_xdg_surface(wl_client* const client, wl_resource* const resource, const uint32_t id, wl_resource* const surface) -> void {
+        const auto state       = static_cast<SurfaceState*>(wl_resource_get_user_data(surface));
+        const auto xdg_surface = wl_resource_create(client, &xdg_surface_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(xdg_surface, &xdg_surface_impl, state, nullptr);
+        state->xdg_surface = xdg_surface;
+    }
+
+    static auto pong(wl_client* /*client*/, wl_resource* /*resource*/, uint32_t /*serial*/) -> void {}
+
+    static inline const struct xdg_wm_base_interface wm_base_impl = {
+        .destroy         = destroy_resource,
+        .get_xdg_surface = get_xdg_surface,
+        .pong            = pong,
+    };
+
+    static auto bind_wm_base(wl_client* const client, void* const data, const uint32_t version, const uint32_t id) -> void {
+        const auto resource = wl_resource_create(client, &xdg_wm_base_interface, version, id);
+        wl_resource_set_implementation(resource, &wm_base_impl, data, nullptr);
+    }
+
+    // zwlr_layer_shell_v1
+    static auto layer_set_size(wl_client* /*client*/, wl_resource* /*resource*/, uint32_t /*width*/, uint32_t /*height*/) -> void {}
+
+    static auto layer_set_uint(wl_client* /*client*/, wl_resource* /*resource*/, uint32_t /*value*/) -> void {}
+
+    static auto layer_set_zone(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*zone*/) -> void {}
+
+    static auto layer_set_margin(wl_client* /*client*/, wl_resource* /*resource*/, int32_t /*top*/, int32_t /*right*/, int32_t /*bottom*/, int32_t /*left*/) -> void {}
+
+    static inline const struct zwlr_layer_surface_v1_interface layer_surface_impl = {
+        .set_size                   = layer_set_size,
+        .set_anchor                 = layer_set_uint,
+        .set_exclusive_zone         = layer_set_zone,
+        .set_margin                 = layer_set_margin,
+        .set_keyboard_interactivity = layer_set_uint,
+        .get_popup                  = nullptr,
+        .ack_configure              = ack_configure,
+        .destroy                    = destroy_resource,
+        .set_layer                  = layer_set_uint,
+    };
+
+    static auto get_layer_surface(wl_client* const client, wl_resource* const resource, const uint32_t id, wl_resource* const surface, wl_resource* /*output*/, uint32_t /*layer*/, const char* /*namespace*/) -> void {
+        const auto state         = static_cast<SurfaceState*>(wl_resource_get_user_data(surface));
+        const auto layer_surface = wl_resource_create(client, &zwlr_layer_surface_v1_interface, wl_resource_get_version(resource), id);
+        wl_resource_set_implementation(layer_surface, &layer_surface_impl, state, nullptr);
+        state->layer_surface = layer_surface;
+    }
+
+    static inline const struct zwlr_layer_shell_v1_interface layer_shell_impl = {
+        .get_layer_surface = get_layer_surface,
+        .destroy           = destroy_resource,
+    };
+
+    static auto bind_layer_shell(wl_client* const client, void* const data, const uint32_t version, const uint32_t id) -> void {
+        const auto resource = wl_resource_create(client, &zwlr_layer_shell_v1_interface, version, id);
+        wl_resource_set_implementation(resource, &layer_shell_impl, data, nullptr);
+    }
+
+    Server() {
+        display = wl_display_create();
+        ASSERT(display != nullptr);
+        ASSERT(wl_display_init_shm(display) == 0);
+        ASSERT(wl_global_create(display, &wl_compositor_interface, 5, this, bind_compositor) != nullptr);
+        ASSERT(wl_global_create(display, &wl_seat_interface, 7, this, bind_seat) != nullptr);
+        ASSERT(wl_global_create(display, &wl_output_interface, 4, this, bind_output) != nullptr);
+        ASSERT(wl_global_create(display, &xdg_wm_base_interface, 6, this, bind_wm_base) != nullptr);
+        ASSERT(wl_global_create(display, &zwlr_layer_shell_v1_interface, 4, this, bind_layer_shell) != nullptr);
+
+        task_fd = eventfd(0, EFD_CLOEXEC);
+        ASSERT(task_fd >= 0);
+        wl_event_loop_add_fd(wl_display_get_event_loop(display), task_fd, WL_EVENT_READABLE, on_task, this);
+
+        thread = std::thread([this]() { wl_display_run(display); });
+    }
+
+    ~Server() {
+        post([this]() { wl_display_terminate(display); });
+        thread.join();
+        wl_display_destroy_clients(display);
+        wl_display_destroy(display);
+        close(task_fd);
+    }
+};
+
+auto MockCompositor::connect() -> int {
+    int fds[2];
+    ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == 0);
+    server->post([this, fd = fds[0]]() { ASSERT(wl_client_create(server->display, fd) != nullptr); });
+    return fds[1];
+}
+
+auto MockCompositor::send_pointer_motion(const uint32_t count) -> void {
+    server->post([this, count]() {
+        const auto time = now_ms();
+        for(const auto pointer : server->pointers) {
+            for(auto i = uint32_t(0); i < count; i += 1) {
+                wl_pointer_send_motion(pointer, time, wl_fixed_from_int(i % 1920), wl_fixed_from_int(i % 1080));
+                if(wl_resource_get_version(pointer) >= WL_POINTER_FRAME_SINCE_VERSION) {
+                    wl_pointer_send_frame(pointer);
+                }
+            }
+        }
+    });
+}
+
+auto MockCompositor::send_keyboard_key(const uint32_t count) -> void {
+    server->post([this, count]() {
+        const auto time = now_ms();
+        for(const auto keyboard : server->keyboards) {
+            for(auto i = uint32_t(0); i < count; i += 1) {
+                const auto serial = wl_display_next_serial(server->display);
+                wl_keyboard_send_key(keyboard, serial, time, 30, i % 2 == 0 ? WL_KEYBOARD_KEY_STATE_PRESSED : WL_KEYBOARD_KEY_STATE_RELEASED);
+            }
+        }
+    });
+}
+
+auto MockCompositor::send_touch_motion(const uint32_t count) -> void {
+    server->post([this, count]() {
+        const auto time = now_ms();
+        for(const auto touch : server->touches) {
+            for(auto i = uint32_t(0); i < count; i += 1) {
+                wl_touch_send_motion(touch, time, 0, wl_fixed_from_int(i % 1920), wl_fixed_from_int(i % 1080));
+                wl_touch_send_frame(touch);
+            }
+        }
+    });
+}
+
+auto MockCompositor::send_output_mode(const uint32_t count) -> void {
+    server->post([this, count]() {
+        for(const auto output : server->outputs) {
+            for(auto i = uint32_t(0); i < count; i += 1) {
+                wl_output_send_mode(output, WL_OUTPUT_MODE_CURRENT, 1920, 1080, 60000);
+                wl_output_send_done(output);
+            }
+        }
+    });
+}
+
+auto MockCompositor::get_commit_count() const -> uint64_t {
+    return server->commits;
+}
+
+MockCompositor::MockCompositor()
+    : server(new Server()) {}
+
+MockCompositor::~MockCompositor() {}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+
+// in-process stand-in compositor built on libwayland-server
+// runs on its own thread and talks to clients over socketpairs
+// implements wl_compositor, wl_shm, wl_seat, wl_output, xdg_wm_base and zwlr_layer_shell_v1 just enough for towl
+class MockCompositor {
+  public:
+    struct Server;
+
+  private:
+    std::unique_ptr<Server> server;
+
+  public:
+    // returns a socket connected to the compositor, to be passed to towl::Display(int)
+    auto connect() -> int;
+    // sends count events to every bound device of every client, followed by frame events where the protocol has them
+    auto send_pointer_motion(uint32_t count) -> void;
+    auto send_keyboard_key(uint32_t count) -> void;
+    auto send_touch_motion(uint32_t count) -> void;
+    auto send_output_mode(uint32_t count) -> void;
+    auto get_commit_count() const -> uint64_t;
+
+    MockCompositor();
+    ~MockCompositor();
+};
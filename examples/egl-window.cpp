@@ -81,7 +81,7 @@ auto main() -> int {
     auto xdg_surface          = wmbase->create_xdg_surface(surface.native());
     xdg_surface.init(&xdg_surface_callback);
     auto xdg_toplevel_callbacks = towl::XDGToplevelCallbacks();
-    auto xdg_toplevel           = xdg_surface.create_xdg_toplevel();
+    auto& xdg_toplevel          = xdg_surface.create_xdg_toplevel();
     xdg_toplevel.init(&xdg_toplevel_callbacks);
 
     // then commit surface changes
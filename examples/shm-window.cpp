@@ -4,6 +4,7 @@
 #include "towl/compositor.hpp"
 #include "towl/display.hpp"
 #include "towl/registry.hpp"
+#include "towl/shm-canvas.hpp"
 #include "towl/shm.hpp"
 #include "towl/xdg-wm-base.hpp"
 #include "util/assert.hpp"
@@ -18,11 +19,7 @@ struct Image {
     uint8_t*      data;
 
     auto fill(const uint32_t pattern) -> void {
-        for(auto y = size_t(0); y < height; y += 1) {
-            for(auto x = size_t(0); x < width; x += 1) {
-                *(reinterpret_cast<uint32_t*>(data) + y * width + x) = pattern;
-            }
-        }
+        towl::ShmCanvas(data, width, height, width * 4, WL_SHM_FORMAT_ARGB8888).clear(pattern);
     }
 
     Image(towl::Shm* shm, const FileDescriptor& unix_shm, const size_t width, const size_t height)
@@ -68,7 +65,7 @@ auto main() -> int {
     auto xdg_surface          = wmbase->create_xdg_surface(surface.native());
     xdg_surface.init(&xdg_surface_callback);
     auto xdg_toplevel_callbacks = towl::XDGToplevelCallbacks();
-    auto xdg_toplevel           = xdg_surface.create_xdg_toplevel();
+    auto& xdg_toplevel          = xdg_surface.create_xdg_toplevel();
     xdg_toplevel.init(&xdg_toplevel_callbacks);
 
     // then commit surface changes
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <utility>
+
+#include "commit-batch.hpp"
+#include "macros/assert.hpp"
+#include "trace.hpp"
+
+namespace towl {
+auto CommitBatch::get_entry(Surface& surface) -> Entry& {
+    for(auto& entry : entries) {
+        if(entry.surface == &surface) {
+            return entry;
+        }
+    }
+    auto& entry   = entries.emplace_back();
+    entry.surface = &surface;
+    return entry;
+}
+
+auto CommitBatch::get_depth(Surface* surface) const -> uint32_t {
+    auto depth = uint32_t(0);
+    while(true) {
+        const auto link = std::ranges::find(links, surface, &Link::child);
+        if(link == links.end()) {
+            return depth;
+        }
+        surface = link->parent;
+        depth += 1;
+    }
+}
+
+auto CommitBatch::take_submissions() -> void {
+    // the stack is in reverse submission order
+    auto head = submissions.exchange(nullptr, std::memory_order_acquire);
+    auto list = std::vector<Submission*>();
+    for(; head != nullptr; head = head->next) {
+        list.push_back(head);
+    }
+    for(auto i = list.rbegin(); i != list.rend(); i += 1) {
+        const auto submission = *i;
+        auto&      entry      = get_entry(*submission->surface);
+        supersede(entry);
+        entry.buffer    = submission->buffer;
+        entry.callbacks = submission->callbacks;
+        entry.x         = 0;
+        entry.y         = 0;
+        entry.attach    = true;
+        entry.commit    = true;
+        entry.damage.add(submission->damage);
+        delete submission;
+    }
+}
+
+auto CommitBatch::supersede(Entry& entry) -> void {
+    if(entry.attach && entry.callbacks != nullptr) {
+        entry.callbacks->on_commit_batch_superseded(entry.surface, entry.buffer);
+    }
+    entry.callbacks = nullptr;
+}
+
+auto CommitBatch::set_parent(Surface& surface, Surface& parent) -> bool {
+    for(auto ancestor = &parent; ancestor != nullptr;) {
+        ensure(ancestor != &surface, "subsurface cycle");
+        const auto link = std::ranges::find(links, ancestor, &Link::child);
+        ancestor        = link != links.end() ? link->parent : nullptr;
+    }
+    for(auto& link : links) {
+        if(link.child == &surface) {
+            link.parent = &parent;
+            return true;
+        }
+    }
+    links.push_back({&surface, &parent});
+    return true;
+}
+
+auto CommitBatch::remove(Surface& surface) -> void {
+    // queued submissions may point to surface
+    take_submissions();
+    for(auto& entry : entries) {
+        if(entry.surface == &surface) {
+            supersede(entry);
+        }
+    }
+    std::erase_if(links, [&surface](const Link& link) { return link.child == &surface || link.parent == &surface; });
+    std::erase_if(entries, [&surface](const Entry& entry) { return entry.surface == &surface; });
+}
+
+auto CommitBatch::attach(Surface& surface, wl_buffer* const buffer, const int32_t x, const int32_t y) -> void {
+    auto& entry = get_entry(surface);
+    supersede(entry);
+    entry.buffer = buffer;
+    entry.x      = x;
+    entry.y      = y;
+    entry.attach = true;
+}
+
+auto CommitBatch::damage(Surface& surface, const Rect& rect) -> void {
+    get_entry(surface).damage.add(rect);
+}
+
+auto CommitBatch::damage(Surface& surface, const DamageRegion& region) -> void {
+    get_entry(surface).damage.add(region);
+}
+
+auto CommitBatch::commit(Surface& surface) -> void {
+    get_entry(surface).commit = true;
+}
+
+auto CommitBatch::submit(Surface& surface, wl_buffer* const buffer, const DamageRegion& damage, CommitBatchCallbacks* const callbacks) -> void {
+    const auto submission = new Submission{nullptr, &surface, buffer, callbacks, damage};
+    submission->next      = submissions.load(std::memory_order_relaxed);
+    while(!submissions.compare_exchange_weak(submission->next, submission, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+auto CommitBatch::issue() -> void {
+    TOWL_TRACE_SCOPE("commit_batch.apply");
+    take_submissions();
+
+    // cached state of synchronized subsurfaces is only applied when the parent commits
+    for(auto i = 0uz; i < entries.size(); i += 1) {
+        if(!entries[i].commit) {
+            continue;
+        }
+        for(auto link = std::ranges::find(links, entries[i].surface, &Link::child); link != links.end(); link = std::ranges::find(links, link->parent, &Link::child)) {
+            get_entry(*link->parent).commit = true;
+        }
+    }
+
+    // deepest first, so that every child is committed before its parent
+    auto depths = std::vector<std::pair<uint32_t, Entry*>>();
+    depths.reserve(entries.size());
+    for(auto& entry : entries) {
+        depths.emplace_back(get_depth(entry.surface), &entry);
+    }
+    std::ranges::stable_sort(depths, std::greater(), &std::pair<uint32_t, Entry*>::first);
+
+    for(const auto& [depth, entry] : depths) {
+        if(entry->attach) {
+            entry->surface->attach(entry->buffer, entry->x, entry->y);
+        }
+        if(!entry->damage.empty()) {
+            entry->surface->damage(entry->damage);
+        }
+        if(entry->commit) {
+            entry->surface->commit();
+        }
+    }
+    entries.clear();
+}
+
+auto CommitBatch::apply(Display& display) -> bool {
+    issue();
+    return display.flush();
+}
+
+auto CommitBatch::async_apply(Display& display) -> coop::Async<bool> {
+    issue();
+    co_return co_await display.async_flush();
+}
+
+auto CommitBatch::empty() const -> bool {
+    return entries.empty() && submissions.load(std::memory_order_relaxed) == nullptr;
+}
+
+CommitBatch::~CommitBatch() {
+    auto head = submissions.exchange(nullptr);
+    while(head != nullptr) {
+        delete std::exchange(head, head->next);
+    }
+}
+} // namespace towl
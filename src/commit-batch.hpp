@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <vector>
+
+#include "compositor.hpp"
+#include "damage.hpp"
+#include "display.hpp"
+
+namespace towl {
+class CommitBatchCallbacks {
+  public:
+    // a buffer passed to CommitBatch::submit was replaced by a later one, or its surface removed, before it was attached
+    // it will never receive wl_buffer.release, reclaim it here, e.g. with ShmSwapchain::discard
+    // called on the thread running apply() or remove()
+    virtual auto on_commit_batch_superseded(Surface* /*surface*/, wl_buffer* /*buffer*/) -> void {}
+    virtual ~CommitBatchCallbacks() {}
+};
+
+// collects attach/damage/commit over many surfaces and sends them at once
+// children are committed before their parents, so that synchronized subsurfaces land in the same frame as the parent
+// apply() issues every request and flushes the display exactly once, async_apply() waits until they are all sent
+class CommitBatch {
+  private:
+    struct Entry {
+        Surface*              surface;
+        wl_buffer*            buffer    = nullptr;
+        CommitBatchCallbacks* callbacks = nullptr; // of the submission that set buffer
+        int32_t               x         = 0;
+        int32_t               y         = 0;
+        DamageRegion          damage;
+        bool                  attach = false;
+        bool                  commit = false;
+    };
+
+    struct Link {
+        Surface* child;
+        Surface* parent;
+    };
+
+    // buffer handed over from a worker thread
+    struct Submission {
+        Submission*           next;
+        Surface*              surface;
+        wl_buffer*            buffer;
+        CommitBatchCallbacks* callbacks;
+        DamageRegion          damage;
+    };
+
+    std::vector<Entry>       entries;
+    std::vector<Link>        links;
+    std::atomic<Submission*> submissions = nullptr;
+
+    auto get_entry(Surface& surface) -> Entry&;
+    auto get_depth(Surface* surface) const -> uint32_t;
+    auto take_submissions() -> void;
+    auto supersede(Entry& entry) -> void;
+    auto issue() -> void;
+
+  public:
+    // declares surface as a subsurface of parent, kept across batches
+    // returns false if parent is surface itself or one of its descendants
+    auto set_parent(Surface& surface, Surface& parent) -> bool;
+    // also drops pending submissions for surface, must not race with submit() for the same surface
+    auto remove(Surface& surface) -> void;
+    auto attach(Surface& surface, wl_buffer* buffer, int32_t x = 0, int32_t y = 0) -> void;
+    auto damage(Surface& surface, const Rect& rect) -> void;
+    auto damage(Surface& surface, const DamageRegion& region) -> void;
+    auto commit(Surface& surface) -> void;
+    // attach + damage + commit, callable from any thread
+    // the buffer is applied by the next apply() on the display thread
+    // if it gets superseded before that, it is handed back through callbacks
+    auto submit(Surface& surface, wl_buffer* buffer, const DamageRegion& damage, CommitBatchCallbacks* callbacks = nullptr) -> void;
+    // sends the batched requests and flushes
+    // returns false if requests are still buffered, see Display::flush
+    auto apply(Display& display) -> bool;
+    auto async_apply(Display& display) -> coop::Async<bool>;
+    auto empty() const -> bool;
+
+    CommitBatch() = default;
+    CommitBatch(CommitBatch&) = delete;
+    ~CommitBatch();
+};
+} // namespace towl
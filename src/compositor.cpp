@@ -1,15 +1,48 @@
+#include <utility>
+
 #include "compositor.hpp"
 #include "macros/assert.hpp"
+#include "shm.hpp"
+#include "trace.hpp"
 
 namespace towl {
+auto Region::native() -> wl_region* {
+    return region.get();
+}
+
+auto Region::add(const int32_t x, const int32_t y, const int32_t width, const int32_t height) -> void {
+    wl_region_add(region.get(), x, y, width, height);
+}
+
+auto Region::add(const Rect& rect) -> void {
+    add(rect.x, rect.y, rect.width, rect.height);
+}
+
+auto Region::subtract(const int32_t x, const int32_t y, const int32_t width, const int32_t height) -> void {
+    wl_region_subtract(region.get(), x, y, width, height);
+}
+
+auto Region::subtract(const Rect& rect) -> void {
+    subtract(rect.x, rect.y, rect.width, rect.height);
+}
+
+Region::Region(wl_region* const region)
+    : region(region) {
+}
+
 auto Surface::enter(void* const data, wl_surface* const /*surface*/, wl_output* const output) -> void {
     auto& self = *std::bit_cast<Surface*>(data);
+    self.output_count += 1;
+    self.output_known = true;
     self.callbacks->on_wl_surface_enter(output);
+    self.update_visibility();
 }
 
 auto Surface::leave(void* const data, wl_surface* const /*surface*/, wl_output* const output) -> void {
     auto& self = *std::bit_cast<Surface*>(data);
+    self.output_count -= 1;
     self.callbacks->on_wl_surface_leave(output);
+    self.update_visibility();
 }
 
 auto Surface::preferred_buffer_scale(void* data, wl_surface* /*surface*/, const int32_t factor) -> void {
@@ -17,10 +50,42 @@ auto Surface::preferred_buffer_scale(void* data, wl_surface* /*surface*/, const
     self.callbacks->on_wl_surface_preferred_buffer_scale(factor);
 }
 
-auto Surface::done(void* const data, wl_callback* const /*wl_callback*/, const uint32_t /*callback_data*/) -> void {
+auto Surface::preferred_buffer_transform(void* const data, wl_surface* const /*surface*/, const uint32_t transform) -> void {
+    auto& self = *std::bit_cast<Surface*>(data);
+    self.callbacks->on_wl_surface_preferred_buffer_transform(transform);
+}
+
+auto Surface::done(void* const data, wl_callback* const /*wl_callback*/, const uint32_t callback_data) -> void {
+    TOWL_TRACE_SCOPE("wl_surface.frame");
     auto& self = *std::bit_cast<Surface*>(data);
     self.frame.reset();
-    self.callbacks->on_wl_surface_frame();
+    self.frame_time    = callback_data;
+    self.frame_stalled = false;
+    if(self.callbacks != nullptr) {
+        self.callbacks->on_wl_surface_frame();
+    }
+    self.update_visibility();
+    for(const auto event : std::exchange(self.frame_events, {})) {
+        event->notify();
+    }
+}
+
+auto Surface::update_visibility() -> void {
+    const auto prev = visible;
+    visible         = !suspended && !frame_stalled && !(output_known && output_count <= 0);
+    if(visible == prev) {
+        return;
+    }
+    // reachable without init() through set_suspended and poll_frame_stall
+    if(callbacks != nullptr) {
+        callbacks->on_wl_surface_visibility(visible);
+    }
+    if(!visible) {
+        return;
+    }
+    for(const auto event : std::exchange(visible_events, {})) {
+        event->notify();
+    }
 }
 
 auto Surface::native() -> wl_surface* {
@@ -28,6 +93,7 @@ auto Surface::native() -> wl_surface* {
 }
 
 auto Surface::attach(wl_buffer* const buffer, const int32_t x, const int32_t y) -> void {
+    TOWL_TRACE_INSTANT("wl_surface.attach", 0);
     wl_surface_attach(surface.get(), buffer, x, y);
 }
 
@@ -35,7 +101,14 @@ auto Surface::damage(const int32_t x, const int32_t y, const int32_t width, cons
     wl_surface_damage_buffer(surface.get(), x, y, width, height);
 }
 
+auto Surface::damage(const DamageRegion& region) -> void {
+    for(const auto& rect : region.get_rects()) {
+        wl_surface_damage_buffer(surface.get(), rect.x, rect.y, rect.width, rect.height);
+    }
+}
+
 auto Surface::commit() -> void {
+    TOWL_TRACE_INSTANT("wl_surface.commit", 0);
     wl_surface_commit(surface.get());
 }
 
@@ -43,6 +116,37 @@ auto Surface::set_buffer_scale(const int32_t scale) -> void {
     wl_surface_set_buffer_scale(surface.get(), scale);
 }
 
+auto Surface::set_buffer_transform(const uint32_t transform) -> void {
+    wl_surface_set_buffer_transform(surface.get(), int32_t(transform));
+}
+
+auto Surface::set_opaque_region(Region* const region) -> void {
+    wl_surface_set_opaque_region(surface.get(), region != nullptr ? region->native() : nullptr);
+}
+
+auto Surface::set_input_region(Region* const region) -> void {
+    wl_surface_set_input_region(surface.get(), region != nullptr ? region->native() : nullptr);
+}
+
+auto Surface::set_empty_input_region() -> bool {
+    ensure(compositor != nullptr);
+    auto region = Region(wl_compositor_create_region(compositor));
+    set_input_region(&region);
+    return true;
+}
+
+auto Surface::update_opaque_region(const uint32_t format, const int32_t width, const int32_t height) -> bool {
+    if(shm_format_has_alpha(format)) {
+        set_opaque_region(nullptr);
+        return true;
+    }
+    ensure(compositor != nullptr);
+    auto region = Region(wl_compositor_create_region(compositor));
+    region.add(0, 0, width, height);
+    set_opaque_region(&region);
+    return true;
+}
+
 auto Surface::init(SurfaceCallbacks* const callbacks) -> bool {
     ensure(surface);
     this->callbacks = callbacks;
@@ -54,15 +158,69 @@ auto Surface::set_frame() -> void {
     if(!frame) {
         frame.reset(wl_surface_frame(surface.get()));
         wl_callback_add_listener(frame.get(), &frame_listener, this);
+        frame_requested = std::chrono::steady_clock::now();
+    }
+}
+
+auto Surface::is_visible() const -> bool {
+    return visible;
+}
+
+auto Surface::set_suspended(const bool flag) -> void {
+    suspended = flag;
+    update_visibility();
+}
+
+auto Surface::poll_frame_stall(const std::chrono::milliseconds timeout) -> bool {
+    if(frame && std::chrono::steady_clock::now() - frame_requested >= timeout) {
+        frame_stalled = true;
+        update_visibility();
     }
+    return visible;
+}
+
+auto Surface::notify_on_visible(coop::SingleEvent* const event) -> void {
+    visible_events.push_back(event);
 }
 
-Surface::Surface(wl_surface* const surface)
-    : surface(surface) {
+auto Surface::cancel_notify_on_visible(coop::SingleEvent* const event) -> void {
+    std::erase(visible_events, event);
+}
+
+auto Surface::wait_visible() -> coop::Async<void> {
+    if(visible) {
+        co_return;
+    }
+    auto event = coop::SingleEvent();
+    notify_on_visible(&event);
+    co_await event;
+}
+
+auto Surface::next_frame() -> coop::Async<uint32_t> {
+    auto event = coop::SingleEvent();
+    set_frame();
+    commit();
+    frame_events.push_back(&event);
+    co_await event;
+    co_return frame_time;
+}
+
+Surface::Surface(wl_surface* const surface, wl_compositor* const compositor)
+    : surface(surface),
+      compositor(compositor) {
 }
 
 auto Compositor::create_surface() -> Surface {
-    return {wl_compositor_create_surface(compositor.get())};
+    return {wl_compositor_create_surface(compositor.get()), compositor.get()};
+}
+
+auto Compositor::create_surface(EventQueue& queue) -> Surface {
+    const auto wrapper = queue.wrap(compositor.get());
+    return {wl_compositor_create_surface(wrapper.get()), compositor.get()};
+}
+
+auto Compositor::create_region() -> Region {
+    return {wl_compositor_create_region(compositor.get())};
 }
 
 Compositor::Compositor(void* const data)
@@ -1,6 +1,13 @@
 #pragma once
+#include <chrono>
+#include <vector>
+
+#include <coop/promise.hpp>
+#include <coop/single-event.hpp>
 #include <wayland-client.h>
 
+#include "damage.hpp"
+#include "event-queue.hpp"
 #include "interface.hpp"
 #include "macros/autoptr.hpp"
 
@@ -8,15 +15,35 @@ namespace towl::impl {
 declare_autoptr(NativeCompositor, wl_compositor, wl_compositor_destroy);
 declare_autoptr(NativeSurface, wl_surface, wl_surface_destroy);
 declare_autoptr(NativeCallback, wl_callback, wl_callback_destroy);
+declare_autoptr(NativeRegion, wl_region, wl_region_destroy);
 } // namespace towl::impl
 
 namespace towl {
+// the compositor copies the region on use, so it can be destroyed right after being set
+class Region {
+  private:
+    impl::AutoNativeRegion region;
+
+  public:
+    auto native() -> wl_region*;
+    auto add(int32_t x, int32_t y, int32_t width, int32_t height) -> void;
+    auto add(const Rect& rect) -> void;
+    auto subtract(int32_t x, int32_t y, int32_t width, int32_t height) -> void;
+    auto subtract(const Rect& rect) -> void;
+
+    Region() = default;
+    Region(wl_region* region);
+};
+
 class SurfaceCallbacks {
   public:
     virtual auto on_wl_surface_enter(wl_output* /*output*/) -> void {}
     virtual auto on_wl_surface_leave(wl_output* /*output*/) -> void {}
     virtual auto on_wl_surface_preferred_buffer_scale(int32_t /*factor*/) -> void {}
+    virtual auto on_wl_surface_preferred_buffer_transform(uint32_t /*transform*/) -> void {}
     virtual auto on_wl_surface_frame() -> void {}
+    // see Surface::is_visible
+    virtual auto on_wl_surface_visibility(bool /*visible*/) -> void {}
     virtual ~SurfaceCallbacks() {}
 };
 
@@ -24,12 +51,27 @@ class Surface {
   private:
     impl::AutoNativeSurface  surface;
     impl::AutoNativeCallback frame;
-    SurfaceCallbacks*        callbacks;
+    wl_compositor*           compositor = nullptr;
+    SurfaceCallbacks*        callbacks  = nullptr; // set by init()
+    uint32_t                 frame_time = 0;
+
+    std::vector<coop::SingleEvent*> frame_events; // next_frame waiters, all woken by the same callback
+
+    // visibility
+    std::chrono::steady_clock::time_point frame_requested;
+    std::vector<coop::SingleEvent*>       visible_events;
+    int                                   output_count  = 0;
+    bool                                  output_known  = false;
+    bool                                  suspended     = false;
+    bool                                  frame_stalled = false;
+    bool                                  visible       = true;
+
+    auto update_visibility() -> void;
 
     static auto enter(void* data, wl_surface* surface, wl_output* output) -> void;
     static auto leave(void* data, wl_surface* surface, wl_output* output) -> void;
     static auto preferred_buffer_scale(void* data, wl_surface* surface, int32_t factor) -> void;
-    static auto preferred_buffer_transform(void* /*data*/, wl_surface* /*surface*/, uint32_t /*transform*/) -> void {};
+    static auto preferred_buffer_transform(void* data, wl_surface* surface, uint32_t transform) -> void;
 
     static inline wl_surface_listener listener = {enter, leave, preferred_buffer_scale, preferred_buffer_transform};
 
@@ -41,13 +83,38 @@ class Surface {
     auto native() -> wl_surface*;
     auto attach(wl_buffer* buffer, int32_t x, int32_t y) -> void;
     auto damage(int32_t x, int32_t y, int32_t width, int32_t height) -> void;
+    auto damage(const DamageRegion& region) -> void;
     auto commit() -> void;
     auto set_buffer_scale(int32_t scale) -> void;
+    // transform is a wl_output_transform the buffer contents are already rendered with, see transform.hpp
+    auto set_buffer_transform(uint32_t transform) -> void;
+    // regions are in surface coordinates, nullptr resets to the default
+    auto set_opaque_region(Region* region) -> void;
+    auto set_input_region(Region* region) -> void;
+    // makes the surface click-through
+    auto set_empty_input_region() -> bool;
+    // marks the whole surface opaque if the buffer format has no alpha channel, otherwise clears the opaque region
+    auto update_opaque_region(uint32_t format, int32_t width, int32_t height) -> bool;
     auto set_frame() -> void;
+    // requests a frame callback, commits, and returns its timestamp in milliseconds
+    // concurrent callers share the pending callback
+    auto next_frame() -> coop::Async<uint32_t>;
+    // false while the surface is on no output, suspended, or its frame callback is overdue
+    auto is_visible() const -> bool;
+    // fed from XDGToplevelState by XDGSurface, see XDGWMBase::create_xdg_surface(Surface&)
+    auto set_suspended(bool flag) -> void;
+    // marks the surface hidden if a frame callback has been pending longer than timeout
+    // for renderers that do not wait for frame callbacks themselves
+    auto poll_frame_stall(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) -> bool;
+    // event is notified once when the surface becomes visible, any number of events can wait at the same time
+    auto notify_on_visible(coop::SingleEvent* event) -> void;
+    // unregisters an event that has not been notified yet
+    auto cancel_notify_on_visible(coop::SingleEvent* event) -> void;
+    auto wait_visible() -> coop::Async<void>;
     auto init(SurfaceCallbacks* callbacks) -> bool;
 
     Surface() = default;
-    Surface(wl_surface* surface);
+    Surface(wl_surface* surface, wl_compositor* compositor = nullptr);
 };
 
 class Compositor : public impl::Interface {
@@ -56,14 +123,25 @@ class Compositor : public impl::Interface {
 
   public:
     auto create_surface() -> Surface;
+    // the surface and its frame callbacks are dispatched on queue
+    auto create_surface(EventQueue& queue) -> Surface;
+    auto create_region() -> Region;
 
     Compositor(void* data);
 };
 
-// version = 1 ~ 4
+// version = 1 ~ 6
+// version 6 is required for the preferred buffer scale and transform hints
 struct CompositorBinder : impl::InterfaceBinder {
+    using Interface = Compositor;
+
+    static constexpr auto interface_name = std::string_view("wl_compositor");
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
 
     CompositorBinder(const uint32_t version)
         : InterfaceBinder(version) {}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "damage.hpp"
+
+namespace towl {
+auto Rect::empty() const -> bool {
+    return width <= 0 || height <= 0;
+}
+
+auto Rect::area() const -> int64_t {
+    return empty() ? 0 : int64_t(width) * height;
+}
+
+auto Rect::contains(const Rect& other) const -> bool {
+    return other.x >= x && other.y >= y && other.x + other.width <= x + width && other.y + other.height <= y + height;
+}
+
+auto Rect::unite(const Rect& other) const -> Rect {
+    if(empty()) {
+        return other;
+    }
+    if(other.empty()) {
+        return *this;
+    }
+    const auto x1 = std::min(x, other.x);
+    const auto y1 = std::min(y, other.y);
+    const auto x2 = std::max(x + width, other.x + other.width);
+    const auto y2 = std::max(y + height, other.y + other.height);
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+auto Rect::intersect(const Rect& other) const -> Rect {
+    const auto x1 = std::max(x, other.x);
+    const auto y1 = std::max(y, other.y);
+    const auto x2 = std::min(x + width, other.x + other.width);
+    const auto y2 = std::min(y + height, other.y + other.height);
+    if(x2 <= x1 || y2 <= y1) {
+        return {};
+    }
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+auto DamageRegion::remove(const uint32_t index) -> void {
+    count -= 1;
+    rects[index] = rects[count];
+}
+
+auto DamageRegion::add(Rect rect) -> void {
+    if(rect.empty()) {
+        return;
+    }
+loop:
+    for(auto i = uint32_t(0); i < count; i += 1) {
+        const auto& r = rects[i];
+        if(r.contains(rect)) {
+            return;
+        }
+        // merge when the union covers no more than the two rects would separately
+        const auto united = r.unite(rect);
+        if(united.area() <= r.area() + rect.area()) {
+            rect = united;
+            remove(i);
+            goto loop;
+        }
+    }
+    if(count < max_rects) {
+        rects[count] = rect;
+        count += 1;
+        return;
+    }
+    // full, merge with the rect that grows the least
+    auto best      = uint32_t(0);
+    auto best_cost = INT64_MAX;
+    for(auto i = uint32_t(0); i < count; i += 1) {
+        const auto cost = rects[i].unite(rect).area() - rects[i].area();
+        if(cost < best_cost) {
+            best      = i;
+            best_cost = cost;
+        }
+    }
+    rect = rects[best].unite(rect);
+    remove(best);
+    add(rect);
+}
+
+auto DamageRegion::add(const DamageRegion& other) -> void {
+    for(const auto& rect : other.get_rects()) {
+        add(rect);
+    }
+}
+
+auto DamageRegion::clip(const Rect& bounds) -> void {
+    for(auto i = uint32_t(0); i < count;) {
+        rects[i] = rects[i].intersect(bounds);
+        if(rects[i].empty()) {
+            remove(i);
+        } else {
+            i += 1;
+        }
+    }
+}
+
+auto DamageRegion::clear() -> void {
+    count = 0;
+}
+
+auto DamageRegion::empty() const -> bool {
+    return count == 0;
+}
+
+auto DamageRegion::get_rects() const -> std::span<const Rect> {
+    return {rects.data(), count};
+}
+
+auto DamageTracker::resize(const int32_t width, const int32_t height) -> void {
+    this->width  = width;
+    this->height = height;
+    frames       = 0;
+    add_full();
+}
+
+auto DamageTracker::add(const Rect& rect) -> void {
+    current.add(rect.intersect({0, 0, width, height}));
+}
+
+auto DamageTracker::add_full() -> void {
+    current.clear();
+    current.add(Rect{0, 0, width, height});
+}
+
+auto DamageTracker::get_buffer_damage(const uint32_t age) const -> DamageRegion {
+    auto region = DamageRegion();
+    if(age == 0 || age - 1 > frames) {
+        region.add(Rect{0, 0, width, height});
+        return region;
+    }
+    region.add(current);
+    for(auto i = uint32_t(0); i + 1 < age; i += 1) {
+        region.add(history[(head + max_age - 1 - i) % max_age]);
+    }
+    return region;
+}
+
+auto DamageTracker::get_current() const -> const DamageRegion& {
+    return current;
+}
+
+auto DamageTracker::end_frame() -> void {
+    history[head] = current;
+    head          = (head + 1) % max_age;
+    frames        = std::min<uint32_t>(frames + 1, max_age);
+    current.clear();
+}
+} // namespace towl
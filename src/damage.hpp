@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace towl {
+struct Rect {
+    int32_t x      = 0;
+    int32_t y      = 0;
+    int32_t width  = 0;
+    int32_t height = 0;
+
+    auto empty() const -> bool;
+    auto area() const -> int64_t;
+    auto contains(const Rect& other) const -> bool;
+    auto unite(const Rect& other) const -> Rect;
+    auto intersect(const Rect& other) const -> Rect;
+};
+
+// bounded set of rectangles, merged when they overlap or when the set is full
+class DamageRegion {
+  public:
+    static constexpr auto max_rects = 8;
+
+  private:
+    std::array<Rect, max_rects> rects;
+    uint32_t                    count = 0;
+
+    auto remove(uint32_t index) -> void;
+
+  public:
+    auto add(Rect rect) -> void;
+    auto add(const DamageRegion& other) -> void;
+    auto clip(const Rect& bounds) -> void;
+    auto clear() -> void;
+    auto empty() const -> bool;
+    auto get_rects() const -> std::span<const Rect>;
+};
+
+// keeps damage of recent frames so that a reused buffer repaints only what changed since it was last drawn
+// age follows EGL_EXT_buffer_age: 0 means undefined contents, n means the buffer holds the frame from n frames ago
+class DamageTracker {
+  public:
+    static constexpr auto max_age = 8;
+
+  private:
+    std::array<DamageRegion, max_age> history;
+    DamageRegion                      current;
+    uint32_t                          head   = 0;
+    uint32_t                          frames = 0;
+    int32_t                           width  = 0;
+    int32_t                           height = 0;
+
+  public:
+    auto resize(int32_t width, int32_t height) -> void;
+    auto add(const Rect& rect) -> void;
+    auto add_full() -> void;
+    auto get_buffer_damage(uint32_t age) const -> DamageRegion;
+    auto get_current() const -> const DamageRegion&;
+    auto end_frame() -> void;
+};
+} // namespace towl
@@ -1,20 +1,28 @@
+#include <algorithm>
+#include <cerrno>
+
+#include <coop/io.hpp>
 #include <coop/single-event.hpp>
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
 
 #include "display.hpp"
 #include "macros/assert.hpp"
+#include "trace.hpp"
 
 namespace towl {
-auto DisplayReadIntent::read() -> void {
+auto DisplayReadIntent::read() -> bool {
     if(done) {
-        return;
+        return true;
     }
-    wl_display_read_events(display);
     done = true;
+    return wl_display_read_events(display) != -1;
 }
 
 auto DisplayReadIntent::cancel() -> void {
     if(!done) {
         wl_display_cancel_read(display);
+        done = true;
     }
 }
 
@@ -54,27 +62,129 @@ auto Display::obtain_read_intent() -> DisplayReadIntent {
 }
 
 auto Display::roundtrip() -> bool {
+    TOWL_TRACE_SCOPE("wl_display.roundtrip");
     return wl_display_roundtrip(display.get()) != 0;
 }
 
 auto Display::dispatch() -> bool {
-    return wl_display_dispatch(display.get()) != -1;
+    TOWL_TRACE_SCOPE("wl_display.dispatch");
+    const auto count = wl_display_dispatch(display.get());
+    TOWL_TRACE_INSTANT("wl_display.dispatched", count);
+    return count != -1;
 }
 
 auto Display::dispatch_pending() -> bool {
-    return wl_display_dispatch_pending(display.get()) != -1;
+    TOWL_TRACE_SCOPE("wl_display.dispatch_pending");
+    const auto count = wl_display_dispatch_pending(display.get());
+    TOWL_TRACE_INSTANT("wl_display.dispatched", count);
+    return count != -1;
+}
+
+auto Display::flush() -> bool {
+    TOWL_TRACE_SCOPE("wl_display.flush");
+    flush_stats.flushes += 1;
+    const auto sent = wl_display_flush(display.get());
+    if(sent < 0) {
+        if(errno == EAGAIN) {
+            flush_stats.eagain += 1;
+        }
+        flush_pending = true;
+        return false;
+    }
+    flush_pending = false;
+    if(sent > 0) {
+        flush_stats.bytes_sent += sent;
+        if(auto queued = 0; sample_queue && ioctl(get_fd(), SIOCOUTQ, &queued) == 0) {
+            flush_stats.peak_queue = std::max(flush_stats.peak_queue, uint32_t(queued));
+        }
+    }
+    return true;
+}
+
+auto Display::async_flush() -> coop::Async<bool> {
+    while(!flush()) {
+        if(errno != EAGAIN) {
+            co_return false;
+        }
+        const auto result = co_await coop::wait_for_file(get_fd(), false, true);
+        if(result.error) {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+auto Display::is_flush_pending() const -> bool {
+    return flush_pending;
+}
+
+auto Display::get_flush_stats() const -> const FlushStats& {
+    return flush_stats;
+}
+
+auto Display::reset_flush_stats() -> void {
+    flush_stats = {};
 }
 
-auto Display::flush() -> void {
-    wl_display_flush(display.get());
+auto Display::set_queue_sampling(const bool flag) -> void {
+    sample_queue = flag;
+}
+
+auto Display::set_max_buffer_size([[maybe_unused]] const size_t size) -> bool {
+#if WAYLAND_VERSION_MAJOR > 1 || WAYLAND_VERSION_MINOR >= 23
+    wl_display_set_max_buffer_size(display.get(), size);
+    return true;
+#else
+    return false;
+#endif
 }
 
 auto Display::get_registry() -> wl_registry* {
     return wl_display_get_registry(display.get());
 }
 
+auto Display::create_event_queue() -> EventQueue {
+    return EventQueue(display.get());
+}
+
+auto Display::async_dispatch() -> coop::Async<bool> {
+    while(true) {
+        // flushing after prepare_read also sends requests made by the handlers obtain_read_intent dispatched
+        auto intent = obtain_read_intent();
+        if(flush()) {
+            const auto result = co_await coop::wait_for_file(get_fd(), true, false);
+            if(result.error) {
+                co_return false;
+            }
+            TOWL_TRACE_INSTANT("wl_display.readable", 0);
+            if(!intent.read()) {
+                co_return false;
+            }
+            co_return dispatch_pending();
+        }
+        // the socket is full, otherwise the requests would stay buffered until the next event arrives
+        // the intent is dropped while waiting so that other readers are not blocked
+        const auto error = errno;
+        intent.cancel();
+        if(error != EAGAIN || !co_await async_flush()) {
+            co_return false;
+        }
+    }
+}
+
+auto Display::run() -> coop::Async<bool> {
+    while(co_await async_dispatch()) {
+    }
+    co_return false;
+}
+
 Display::Display() {
     display.reset(wl_display_connect(nullptr));
     ASSERT(display != NULL);
 }
+
+Display::Display(const int fd) {
+    display.reset(wl_display_connect_to_fd(fd));
+    ASSERT(display != NULL);
+}
 }; // namespace towl
@@ -3,6 +3,7 @@
 #include <coop/promise.hpp>
 #include <wayland-client.h>
 
+#include "event-queue.hpp"
 #include "macros/autoptr.hpp"
 
 namespace towl::impl {
@@ -16,7 +17,7 @@ class DisplayReadIntent {
     bool        done = false;
 
   public:
-    auto read() -> void;
+    auto read() -> bool;
     auto cancel() -> void;
 
     auto operator=(DisplayReadIntent&) -> DisplayReadIntent& = delete;
@@ -26,9 +27,19 @@ class DisplayReadIntent {
     ~DisplayReadIntent();
 };
 
+struct FlushStats {
+    uint64_t flushes    = 0;
+    uint64_t eagain     = 0; // flushes that left requests buffered because the socket was full
+    uint64_t bytes_sent = 0;
+    uint32_t peak_queue = 0; // largest number of unsent bytes seen in the socket send queue, see Display::set_queue_sampling
+};
+
 class Display {
   private:
     impl::AutoNativeDisplay display;
+    FlushStats              flush_stats;
+    bool                    flush_pending = false;
+    bool                    sample_queue  = false;
 
     static auto done(void* const data, wl_callback* const callback, const uint32_t time) -> void;
 
@@ -42,9 +53,28 @@ class Display {
     auto roundtrip() -> bool;
     auto dispatch() -> bool;
     auto dispatch_pending() -> bool;
-    auto flush() -> void;
+    // returns false if requests are still buffered, either because the socket is full or on error
+    auto flush() -> bool;
+    // flushes, waiting for the socket to become writable as many times as needed
+    auto async_flush() -> coop::Async<bool>;
+    auto is_flush_pending() const -> bool;
+    auto get_flush_stats() const -> const FlushStats&;
+    auto reset_flush_stats() -> void;
+    // samples the socket send queue after every flush for FlushStats::peak_queue, costs one ioctl per flush
+    auto set_queue_sampling(bool flag) -> void;
+    // raises the size of the connection buffers, returns false if libwayland does not support it (< 1.23)
+    // size 0 means unbounded
+    auto set_max_buffer_size(size_t size) -> bool;
     auto get_registry() -> wl_registry*;
+    auto create_event_queue() -> EventQueue;
+    // waits for the display fd to be readable in the coop runner, then reads and dispatches events
+    // do not call blocking dispatch()/roundtrip() from other tasks while this is suspended
+    auto async_dispatch() -> coop::Async<bool>;
+    // async_dispatch() until the connection fails
+    auto run() -> coop::Async<bool>;
 
     Display();
+    // takes ownership of a connected socket
+    Display(int fd);
 };
 } // namespace towl
@@ -0,0 +1,43 @@
+#include <coop/single-event.hpp>
+
+#include "event-queue.hpp"
+#include "macros/assert.hpp"
+
+namespace towl {
+auto EventQueue::done(void* const data, wl_callback* const callback, const uint32_t /*time*/) -> void {
+    auto& event = *std::bit_cast<coop::SingleEvent*>(data);
+    event.notify();
+    wl_callback_destroy(callback);
+}
+
+auto EventQueue::native() -> wl_event_queue* {
+    return queue.get();
+}
+
+auto EventQueue::dispatch() -> bool {
+    return wl_display_dispatch_queue(display, queue.get()) != -1;
+}
+
+auto EventQueue::dispatch_pending() -> bool {
+    return wl_display_dispatch_queue_pending(display, queue.get()) != -1;
+}
+
+auto EventQueue::roundtrip() -> bool {
+    return wl_display_roundtrip_queue(display, queue.get()) != -1;
+}
+
+auto EventQueue::wait_sync() -> coop::Async<void> {
+    auto event   = coop::SingleEvent();
+    auto wrapper = wrap(display);
+    auto sync    = wl_display_sync(wrapper.get());
+    wl_callback_add_listener(sync, &listener, &event);
+    wl_display_flush(display);
+    co_await event;
+}
+
+EventQueue::EventQueue(wl_display* const display)
+    : display(display),
+      queue(wl_display_create_queue(display)) {
+    ASSERT(queue);
+}
+} // namespace towl
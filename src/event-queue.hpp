@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+
+#include <coop/promise.hpp>
+#include <wayland-client.h>
+
+#include "macros/autoptr.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativeEventQueue, wl_event_queue, wl_event_queue_destroy);
+
+struct AutoProxyWrapperDeleter {
+    auto operator()(void* const proxy) -> void {
+        wl_proxy_wrapper_destroy(proxy);
+    }
+};
+
+template <class T>
+using AutoProxyWrapper = std::unique_ptr<T, AutoProxyWrapperDeleter>;
+} // namespace towl::impl
+
+namespace towl {
+// objects created through this queue deliver their events only when the queue is dispatched
+// so that e.g. a render thread can wait for its frame callbacks without touching the input queue
+class EventQueue {
+  private:
+    wl_display*                display;
+    impl::AutoNativeEventQueue queue;
+
+    static auto done(void* data, wl_callback* callback, uint32_t time) -> void;
+
+    static inline wl_callback_listener listener = {done};
+
+  public:
+    auto native() -> wl_event_queue*;
+    // requests sent through the wrapper create objects on this queue
+    template <class T>
+    auto wrap(T* const proxy) -> impl::AutoProxyWrapper<T> {
+        const auto wrapper = std::bit_cast<T*>(wl_proxy_create_wrapper(proxy));
+        wl_proxy_set_queue(std::bit_cast<wl_proxy*>(wrapper), queue.get());
+        return impl::AutoProxyWrapper<T>(wrapper);
+    }
+    // moves an existing object to this queue, do this before its first event arrives
+    template <class T>
+    auto assign(T* const proxy) -> void {
+        wl_proxy_set_queue(std::bit_cast<wl_proxy*>(proxy), queue.get());
+    }
+    auto dispatch() -> bool;
+    auto dispatch_pending() -> bool;
+    auto roundtrip() -> bool;
+    auto wait_sync() -> coop::Async<void>;
+
+    EventQueue(wl_display* display);
+};
+} // namespace towl
@@ -0,0 +1,130 @@
+#include <unistd.h>
+
+#include "event-stream.hpp"
+
+namespace towl {
+auto EventStream::on_wl_pointer_enter(wl_surface* const surface, const double x, const double y) -> void {
+    push({.type = Event::Type::PointerEnter, .position = {surface, x, y}});
+}
+
+auto EventStream::on_wl_pointer_motion(const double x, const double y) -> void {
+    push({.type = Event::Type::PointerMotion, .position = {nullptr, x, y}});
+}
+
+auto EventStream::on_wl_pointer_leave(wl_surface* const surface) -> void {
+    push({.type = Event::Type::PointerLeave, .position = {surface, 0, 0}});
+}
+
+auto EventStream::on_wl_pointer_button(const uint32_t button, const uint32_t state) -> void {
+    push({.type = Event::Type::PointerButton, .button = {button, state}});
+}
+
+auto EventStream::on_wl_pointer_axis(const uint32_t axis, const double value) -> void {
+    push({.type = Event::Type::PointerAxis, .axis = {axis, value}});
+}
+
+auto EventStream::on_wl_pointer_frame() -> void {
+    push({.type = Event::Type::PointerFrame, .position = {}});
+}
+
+auto EventStream::on_wl_keyboard_keymap(const uint32_t /*format*/, const int32_t fd, const uint32_t /*size*/) -> void {
+    close(fd);
+}
+
+auto EventStream::on_wl_keyboard_enter(wl_surface* const surface, const Array<uint32_t>& /*keys*/) -> void {
+    push({.type = Event::Type::KeyboardEnter, .position = {surface, 0, 0}});
+}
+
+auto EventStream::on_wl_keyboard_leave(wl_surface* const surface) -> void {
+    push({.type = Event::Type::KeyboardLeave, .position = {surface, 0, 0}});
+}
+
+auto EventStream::on_wl_keyboard_key(const uint32_t key, const uint32_t state) -> void {
+    push({.type = Event::Type::KeyboardKey, .key = {key, state}});
+}
+
+auto EventStream::on_wl_keyboard_modifiers(const uint32_t mods_depressed, const uint32_t mods_latched, const uint32_t mods_locked, const uint32_t group) -> void {
+    push({.type = Event::Type::KeyboardModifiers, .modifiers = {mods_depressed, mods_latched, mods_locked, group}});
+}
+
+auto EventStream::on_wl_keyboard_repeat_info(const int32_t rate, const int32_t delay) -> void {
+    push({.type = Event::Type::KeyboardRepeatInfo, .repeat_info = {rate, delay}});
+}
+
+auto EventStream::on_wl_touch_down(wl_surface* const surface, const uint32_t id, const double x, const double y) -> void {
+    push({.type = Event::Type::TouchDown, .touch = {surface, id, x, y}});
+}
+
+auto EventStream::on_wl_touch_motion(const uint32_t id, const double x, const double y) -> void {
+    push({.type = Event::Type::TouchMotion, .touch = {nullptr, id, x, y}});
+}
+
+auto EventStream::on_wl_touch_up(const uint32_t id) -> void {
+    push({.type = Event::Type::TouchUp, .touch = {nullptr, id, 0, 0}});
+}
+
+auto EventStream::on_wl_touch_frame() -> void {
+    push({.type = Event::Type::TouchFrame, .touch = {}});
+}
+
+auto EventStream::on_wl_surface_enter(wl_output* const output) -> void {
+    push({.type = Event::Type::SurfaceEnter, .output = {output, 0, 0, 0, 0}});
+}
+
+auto EventStream::on_wl_surface_leave(wl_output* const output) -> void {
+    push({.type = Event::Type::SurfaceLeave, .output = {output, 0, 0, 0, 0}});
+}
+
+auto EventStream::on_wl_surface_preferred_buffer_scale(const int32_t factor) -> void {
+    push({.type = Event::Type::SurfaceScale, .output = {nullptr, 0, 0, 0, factor}});
+}
+
+auto EventStream::on_wl_output_mode(wl_output* const output, const uint32_t /*flags*/, const int32_t width, const int32_t height, const int32_t refresh) -> void {
+    push({.type = Event::Type::OutputMode, .output = {output, width, height, refresh, 0}});
+}
+
+auto EventStream::on_wl_output_done(wl_output* const output) -> void {
+    push({.type = Event::Type::OutputDone, .output = {output, 0, 0, 0, 0}});
+}
+
+auto EventStream::on_wl_output_scale(wl_output* const output, const int32_t scale) -> void {
+    push({.type = Event::Type::OutputScale, .output = {output, 0, 0, 0, scale}});
+}
+
+auto EventStream::on_xdg_toplevel_configure(const XDGToplevelState& state) -> void {
+    push({.type = Event::Type::Configure, .configure = {state.width, state.height}});
+}
+
+auto EventStream::on_xdg_toplevel_close() -> void {
+    push({.type = Event::Type::Close, .configure = {}});
+}
+
+auto EventStream::on_zwlr_layer_surface_configure(const uint32_t width, const uint32_t height) -> void {
+    push({.type = Event::Type::Configure, .configure = {int32_t(width), int32_t(height)}});
+}
+
+auto EventStream::on_zwlr_layer_surface_closed() -> void {
+    push({.type = Event::Type::Close, .configure = {}});
+}
+
+auto EventStream::events() -> coop::Generator<Event> {
+    while(!ring.empty()) {
+        co_yield ring.pop();
+    }
+}
+
+auto EventStream::push(const Event& event) -> void {
+    ring.push(event);
+}
+
+auto EventStream::clear() -> void {
+    ring.clear();
+}
+
+auto EventStream::get_dropped_count() const -> size_t {
+    return ring.get_dropped_count();
+}
+
+EventStream::EventStream(const size_t capacity, const bool coalesce_motion)
+    : ring(capacity, coalesce_motion) {}
+} // namespace towl
@@ -0,0 +1,77 @@
+#pragma once
+#include <coop/generator.hpp>
+
+#include "compositor.hpp"
+#include "event.hpp"
+#include "keyboard.hpp"
+#include "layer-shell.hpp"
+#include "output.hpp"
+#include "pointer.hpp"
+#include "touch.hpp"
+#include "xdg-wm-base.hpp"
+
+namespace towl {
+// pull-model alternative to the callback interfaces
+// pass the stream as callbacks to the objects of interest, then drain events() once per frame
+// events are buffered without their source object, so use one stream per window if the source matters
+class EventStream : public PointerCallbacks,
+                    public KeyboardCallbacks,
+                    public TouchCallbacks,
+                    public SurfaceCallbacks,
+                    public OutputCallbacks,
+                    public XDGToplevelCallbacks,
+                    public LayerSurfaceCallbacks {
+  private:
+    EventRing ring;
+
+  public:
+    // PointerCallbacks
+    auto on_wl_pointer_enter(wl_surface* surface, double x, double y) -> void override;
+    auto on_wl_pointer_motion(double x, double y) -> void override;
+    auto on_wl_pointer_leave(wl_surface* surface) -> void override;
+    auto on_wl_pointer_button(uint32_t button, uint32_t state) -> void override;
+    auto on_wl_pointer_axis(uint32_t axis, double value) -> void override;
+    auto on_wl_pointer_frame() -> void override;
+
+    // KeyboardCallbacks
+    // keymaps are not buffered and their fd is closed, decode keys with a dedicated KeyboardCallbacks if needed
+    auto on_wl_keyboard_keymap(uint32_t format, int32_t fd, uint32_t size) -> void override;
+    auto on_wl_keyboard_enter(wl_surface* surface, const Array<uint32_t>& keys) -> void override;
+    auto on_wl_keyboard_leave(wl_surface* surface) -> void override;
+    auto on_wl_keyboard_key(uint32_t key, uint32_t state) -> void override;
+    auto on_wl_keyboard_modifiers(uint32_t mods_depressed, uint32_t mods_latched, uint32_t mods_locked, uint32_t group) -> void override;
+    auto on_wl_keyboard_repeat_info(int32_t rate, int32_t delay) -> void override;
+
+    // TouchCallbacks
+    auto on_wl_touch_down(wl_surface* surface, uint32_t id, double x, double y) -> void override;
+    auto on_wl_touch_motion(uint32_t id, double x, double y) -> void override;
+    auto on_wl_touch_up(uint32_t id) -> void override;
+    auto on_wl_touch_frame() -> void override;
+
+    // SurfaceCallbacks
+    auto on_wl_surface_enter(wl_output* output) -> void override;
+    auto on_wl_surface_leave(wl_output* output) -> void override;
+    auto on_wl_surface_preferred_buffer_scale(int32_t factor) -> void override;
+
+    // OutputCallbacks
+    auto on_wl_output_mode(wl_output* output, uint32_t flags, int32_t width, int32_t height, int32_t refresh) -> void override;
+    auto on_wl_output_done(wl_output* output) -> void override;
+    auto on_wl_output_scale(wl_output* output, int32_t scale) -> void override;
+
+    // XDGToplevelCallbacks
+    auto on_xdg_toplevel_configure(const XDGToplevelState& state) -> void override;
+    auto on_xdg_toplevel_close() -> void override;
+
+    // LayerSurfaceCallbacks
+    auto on_zwlr_layer_surface_configure(uint32_t width, uint32_t height) -> void override;
+    auto on_zwlr_layer_surface_closed() -> void override;
+
+    // yields every buffered event in arrival order
+    auto events() -> coop::Generator<Event>;
+    auto push(const Event& event) -> void;
+    auto clear() -> void;
+    auto get_dropped_count() const -> size_t;
+
+    EventStream(size_t capacity = 256, bool coalesce_motion = true);
+};
+} // namespace towl
@@ -0,0 +1,86 @@
+#include <bit>
+
+#include "event.hpp"
+
+namespace towl {
+namespace {
+auto get_frame_type(const Event::Type motion) -> Event::Type {
+    return motion == Event::Type::PointerMotion ? Event::Type::PointerFrame : Event::Type::TouchFrame;
+}
+} // namespace
+
+auto EventRing::find_coalesce_target(const Event& event, bool& across_frame) -> Event* {
+    auto count = size();
+    if(count == 0) {
+        return nullptr;
+    }
+    // v5+ pointers and touch send a frame after every group, look into the previous group
+    across_frame = events[(tail - 1) & mask].type == get_frame_type(event.type);
+    if(across_frame) {
+        count -= 1;
+    }
+    // a touch group may hold motions of several points
+    for(auto pos = head + count; pos != head; pos -= 1) {
+        auto& last = events[(pos - 1) & mask];
+        if(last.type != event.type) {
+            return nullptr;
+        }
+        if(event.type == Event::Type::PointerMotion || last.touch.id == event.touch.id) {
+            return &last;
+        }
+    }
+    return nullptr;
+}
+
+auto EventRing::push(const Event& event) -> void {
+    if(coalesce_motion && (event.type == Event::Type::PointerMotion || event.type == Event::Type::TouchMotion)) {
+        auto across_frame = false;
+        if(const auto target = find_coalesce_target(event, across_frame); target != nullptr) {
+            *target = event;
+            if(across_frame) {
+                // the frame closing this motion is already buffered
+                drop_frame = get_frame_type(event.type);
+            }
+            return;
+        }
+    }
+    if(drop_frame && *drop_frame == event.type) {
+        drop_frame.reset();
+        return;
+    }
+    drop_frame.reset();
+    if(size() == events.size()) {
+        head += 1;
+        dropped += 1;
+    }
+    events[tail & mask] = event;
+    tail += 1;
+}
+
+auto EventRing::pop() -> Event {
+    const auto event = events[head & mask];
+    head += 1;
+    return event;
+}
+
+auto EventRing::clear() -> void {
+    head = tail;
+}
+
+auto EventRing::empty() const -> bool {
+    return head == tail;
+}
+
+auto EventRing::size() const -> size_t {
+    return tail - head;
+}
+
+auto EventRing::get_dropped_count() const -> size_t {
+    return dropped;
+}
+
+EventRing::EventRing(const size_t capacity, const bool coalesce_motion)
+    : events(std::bit_ceil(capacity < 2 ? 2 : capacity)),
+      mask(events.size() - 1),
+      coalesce_motion(coalesce_motion) {}
+} // namespace towl
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <wayland-client.h>
+
+namespace towl {
+// compact tagged union of the events delivered through EventStream
+struct Event {
+    enum class Type : uint8_t {
+        PointerEnter,
+        PointerLeave,
+        PointerMotion,
+        PointerButton,
+        PointerAxis,
+        PointerFrame,
+        KeyboardEnter,
+        KeyboardLeave,
+        KeyboardKey,
+        KeyboardModifiers,
+        KeyboardRepeatInfo,
+        TouchDown,
+        TouchMotion,
+        TouchUp,
+        TouchFrame,
+        SurfaceEnter,
+        SurfaceLeave,
+        SurfaceScale,
+        OutputMode,
+        OutputScale,
+        OutputDone,
+        Configure,
+        Close,
+    };
+
+    struct Position {
+        wl_surface* surface; // null for motion
+        double      x;
+        double      y;
+    };
+
+    struct Button {
+        uint32_t button;
+        uint32_t state;
+    };
+
+    struct Axis {
+        uint32_t axis;
+        double   value;
+    };
+
+    struct Key {
+        uint32_t key;
+        uint32_t state;
+    };
+
+    struct Modifiers {
+        uint32_t depressed;
+        uint32_t latched;
+        uint32_t locked;
+        uint32_t group;
+    };
+
+    struct RepeatInfo {
+        int32_t rate;
+        int32_t delay;
+    };
+
+    struct Touch {
+        wl_surface* surface; // only for down
+        uint32_t    id;
+        double      x;
+        double      y;
+    };
+
+    struct Output {
+        wl_output* output;
+        int32_t    width;   // mode
+        int32_t    height;  // mode
+        int32_t    refresh; // mode
+        int32_t    scale;   // scale
+    };
+
+    struct Configure {
+        int32_t width;
+        int32_t height;
+    };
+
+    Type type;
+    union {
+        Position   position;    // PointerEnter, PointerLeave, PointerMotion, KeyboardEnter, KeyboardLeave
+        Button     button;      // PointerButton
+        Axis       axis;        // PointerAxis
+        Key        key;         // KeyboardKey
+        Modifiers  modifiers;   // KeyboardModifiers
+        RepeatInfo repeat_info; // KeyboardRepeatInfo
+        Touch      touch;       // TouchDown, TouchMotion, TouchUp
+        Output     output;      // SurfaceEnter, SurfaceLeave, SurfaceScale, OutputMode, OutputScale, OutputDone
+        Configure  configure;   // Configure
+    };
+};
+
+// fixed capacity fifo, the oldest event is dropped when full
+class EventRing {
+  private:
+    std::vector<Event> events;
+    size_t             mask;
+    size_t             head    = 0; // next read
+    size_t             tail    = 0; // next write
+    size_t             dropped = 0;
+    bool               coalesce_motion;
+    // frame type to swallow because its motion was merged into an earlier, already framed group
+    std::optional<Event::Type> drop_frame;
+
+    auto find_coalesce_target(const Event& event, bool& across_frame) -> Event*;
+
+  public:
+    auto push(const Event& event) -> void;
+    auto pop() -> Event;
+    auto clear() -> void;
+    auto empty() const -> bool;
+    auto size() const -> size_t;
+    auto get_dropped_count() const -> size_t;
+
+    // capacity is rounded up to a power of two
+    // if coalesce_motion is set, consecutive PointerMotion and TouchMotion(same id) events are merged into the latest one
+    EventRing(size_t capacity, bool coalesce_motion);
+};
+} // namespace towl
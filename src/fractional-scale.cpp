@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cmath>
+
+#include "fractional-scale.hpp"
+#include "macros/assert.hpp"
+
+namespace towl {
+auto FractionalScale::preferred_scale(void* const data, wp_fractional_scale_v1* const /*scale*/, const uint32_t value) -> void {
+    auto& self = *std::bit_cast<FractionalScale*>(data);
+    self.callbacks->on_wp_fractional_scale_preferred_scale(value);
+}
+
+auto FractionalScale::init(FractionalScaleCallbacks* const callbacks) -> bool {
+    ensure(scale != NULL);
+    this->callbacks = callbacks;
+    wp_fractional_scale_v1_add_listener(scale.get(), &listener, this);
+    return true;
+}
+
+FractionalScale::FractionalScale(wp_fractional_scale_v1* const scale)
+    : scale(scale) {
+}
+
+auto FractionalScaleManager::get_fractional_scale(Surface& surface) -> FractionalScale {
+    return {wp_fractional_scale_manager_v1_get_fractional_scale(manager.get(), surface.native())};
+}
+
+FractionalScaleManager::FractionalScaleManager(void* const data)
+    : manager(std::bit_cast<wp_fractional_scale_manager_v1*>(data)) {}
+
+auto FractionalScaleManagerBinder::get_interface_description() -> const wl_interface* {
+    return &wp_fractional_scale_manager_v1_interface;
+}
+
+auto FractionalScaleManagerBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
+    return std::unique_ptr<impl::Interface>(new FractionalScaleManager(data));
+}
+
+auto FractionalScaler::on_wp_fractional_scale_preferred_scale(const uint32_t scale) -> void {
+    if(scale == scale120) {
+        return;
+    }
+    scale120 = scale;
+    if(callbacks != nullptr) {
+        callbacks->on_wp_fractional_scale_preferred_scale(scale);
+    }
+}
+
+auto FractionalScaler::set_size(const int32_t width, const int32_t height) -> void {
+    this->width  = width;
+    this->height = height;
+}
+
+auto FractionalScaler::set_resolution_factor(const double factor) -> void {
+    resolution = std::clamp(factor, 0.01, 1.0);
+}
+
+auto FractionalScaler::get_scale() const -> uint32_t {
+    return scale120;
+}
+
+auto FractionalScaler::get_buffer_size() const -> std::pair<int32_t, int32_t> {
+    // the protocol defines the buffer size as round(size * scale / 120)
+    const auto factor = scale120 / 120.0 * resolution;
+    return {
+        std::max(int32_t(std::lround(width * factor)), 1),
+        std::max(int32_t(std::lround(height * factor)), 1),
+    };
+}
+
+auto FractionalScaler::apply() -> void {
+    surface->set_buffer_scale(1);
+    viewport.set_destination(width, height);
+}
+
+auto FractionalScaler::get_viewport() -> Viewport& {
+    return viewport;
+}
+
+auto FractionalScaler::init(FractionalScaleCallbacks* const callbacks) -> bool {
+    this->callbacks = callbacks;
+    ensure(scale.init(this));
+    return true;
+}
+
+FractionalScaler::FractionalScaler(Surface& surface, Viewporter& viewporter, FractionalScaleManager& manager)
+    : surface(&surface),
+      viewport(viewporter.get_viewport(surface)),
+      scale(manager.get_fractional_scale(surface)),
+      callbacks(nullptr) {
+}
+} // namespace towl
@@ -0,0 +1,100 @@
+#pragma once
+#include <utility>
+
+#include <fractional-scale-v1.h>
+
+#include "compositor.hpp"
+#include "interface.hpp"
+#include "macros/autoptr.hpp"
+#include "viewporter.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativeFractionalScaleManager, wp_fractional_scale_manager_v1, wp_fractional_scale_manager_v1_destroy);
+declare_autoptr(NativeFractionalScale, wp_fractional_scale_v1, wp_fractional_scale_v1_destroy);
+} // namespace towl::impl
+
+namespace towl {
+class FractionalScaleCallbacks {
+  public:
+    // scale is in 1/120ths, e.g. 150 for 1.25x
+    virtual auto on_wp_fractional_scale_preferred_scale(uint32_t /*scale*/) -> void {}
+    virtual ~FractionalScaleCallbacks() {}
+};
+
+class FractionalScale {
+  private:
+    impl::AutoNativeFractionalScale scale;
+    FractionalScaleCallbacks*       callbacks;
+
+    static auto preferred_scale(void* data, wp_fractional_scale_v1* scale, uint32_t value) -> void;
+
+    static inline wp_fractional_scale_v1_listener listener = {preferred_scale};
+
+  public:
+    auto init(FractionalScaleCallbacks* callbacks) -> bool;
+
+    FractionalScale() = default;
+    FractionalScale(wp_fractional_scale_v1* scale);
+};
+
+class FractionalScaleManager : public impl::Interface {
+  private:
+    impl::AutoNativeFractionalScaleManager manager;
+
+  public:
+    auto get_fractional_scale(Surface& surface) -> FractionalScale;
+
+    FractionalScaleManager(void* data);
+};
+
+// version = 1
+struct FractionalScaleManagerBinder : impl::InterfaceBinder {
+    using Interface = FractionalScaleManager;
+
+    static constexpr auto interface_name = std::string_view("wp_fractional_scale_manager_v1");
+
+    auto get_interface_description() -> const wl_interface* override;
+    auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
+
+    FractionalScaleManagerBinder(const uint32_t version)
+        : InterfaceBinder(version) {}
+};
+
+// renders a surface at exactly its preferred fractional scale
+// the buffer is allocated at get_buffer_size() and mapped back to the logical size with a viewport
+// the resolution factor shrinks the buffer further and lets the compositor upscale, for dynamic resolution under load
+class FractionalScaler : public FractionalScaleCallbacks {
+  private:
+    Surface*                  surface;
+    Viewport                  viewport;
+    FractionalScale           scale;
+    FractionalScaleCallbacks* callbacks; // nullable
+    uint32_t                  scale120   = 120;
+    double                    resolution = 1.0;
+    int32_t                   width      = 0;
+    int32_t                   height     = 0;
+
+  public:
+    auto on_wp_fractional_scale_preferred_scale(uint32_t scale) -> void override;
+
+    // logical surface size
+    auto set_size(int32_t width, int32_t height) -> void;
+    // clamped to (0, 1]
+    auto set_resolution_factor(double factor) -> void;
+    auto get_scale() const -> uint32_t;
+    auto get_buffer_size() const -> std::pair<int32_t, int32_t>;
+    // updates the viewport, call before committing a buffer of get_buffer_size()
+    auto apply() -> void;
+    // the viewport of the surface, a surface can have only one
+    auto get_viewport() -> Viewport&;
+    auto init(FractionalScaleCallbacks* callbacks) -> bool;
+
+    // the fractional scale listener points to this object
+    FractionalScaler(FractionalScaler&)  = delete;
+    FractionalScaler(FractionalScaler&&) = delete;
+    FractionalScaler(Surface& surface, Viewporter& viewporter, FractionalScaleManager& manager);
+};
+} // namespace towl
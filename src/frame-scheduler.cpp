@@ -0,0 +1,48 @@
+#include <utility>
+
+#include "frame-scheduler.hpp"
+
+namespace towl {
+auto FrameScheduler::request_redraw() -> void {
+    redraw_requested = true;
+    if(const auto event = std::exchange(redraw_event, nullptr); event != nullptr) {
+        event->notify();
+    }
+}
+
+auto FrameScheduler::run(const std::function<void(uint32_t time)> render) -> coop::Async<void> {
+    running   = true;
+    auto time = uint32_t(0);
+    while(running) {
+        if(!redraw_requested) {
+            auto event   = coop::SingleEvent();
+            redraw_event = &event;
+            co_await event;
+            continue;
+        }
+        if(!surface->is_visible()) {
+            // woken by either visibility or request_redraw()/stop(), unregister from the other before the event goes away
+            auto event   = coop::SingleEvent();
+            redraw_event = &event;
+            surface->notify_on_visible(&event);
+            co_await event;
+            surface->cancel_notify_on_visible(&event);
+            redraw_event = nullptr;
+            continue;
+        }
+        redraw_requested = false;
+        render(time);
+        time = co_await surface->next_frame();
+    }
+}
+
+auto FrameScheduler::stop() -> void {
+    running = false;
+    if(const auto event = std::exchange(redraw_event, nullptr); event != nullptr) {
+        event->notify();
+    }
+}
+
+FrameScheduler::FrameScheduler(Surface& surface)
+    : surface(&surface) {}
+} // namespace towl
@@ -0,0 +1,24 @@
+#pragma once
+#include <functional>
+
+#include "compositor.hpp"
+
+namespace towl {
+// coalesces redraw requests into at most one render per frame callback
+// rendering is paused while the surface is not visible
+class FrameScheduler {
+  private:
+    Surface*           surface;
+    coop::SingleEvent* redraw_event     = nullptr;
+    bool               redraw_requested = false;
+    bool               running          = false;
+
+  public:
+    auto request_redraw() -> void;
+    // render is called with the timestamp of the latest frame callback, and must attach and damage but not commit
+    auto run(std::function<void(uint32_t time)> render) -> coop::Async<void>;
+    auto stop() -> void;
+
+    FrameScheduler(Surface& surface);
+};
+} // namespace towl
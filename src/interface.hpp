@@ -1,5 +1,7 @@
 #pragma once
 #include <memory>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 #include <wayland-client.h>
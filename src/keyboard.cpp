@@ -1,4 +1,5 @@
 #include "keyboard.hpp"
+#include "trace.hpp"
 
 namespace towl::impl {
 auto AutoNativeKeyboardDeleter::operator()(wl_keyboard* const keyboard) -> void {
@@ -12,31 +13,37 @@ auto AutoNativeKeyboardDeleter::operator()(wl_keyboard* const keyboard) -> void
 
 namespace towl {
 auto Keyboard::keymap(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t format, const int32_t fd, const uint32_t size) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.keymap");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_keymap(format, fd, size);
 }
 
 auto Keyboard::enter(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, wl_surface* const surface, wl_array* const keys) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.enter");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_enter(surface, *keys);
 }
 
 auto Keyboard::leave(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, wl_surface* const surface) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.leave");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_leave(surface);
 }
 
 auto Keyboard::key(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, const uint32_t /*time*/, const uint32_t key, const uint32_t state) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.key");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_key(key, state);
 }
 
 auto Keyboard::modifiers(void* data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, const uint32_t mods_depressed, const uint32_t mods_latched, const uint32_t mods_locked, const uint32_t group) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.modifiers");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_modifiers(mods_depressed, mods_latched, mods_locked, group);
 }
 
 auto Keyboard::repeat_info(void* const data, wl_keyboard* const /*wl_keyboard*/, const int32_t rate, const int32_t delay) -> void {
+    TOWL_TRACE_SCOPE("wl_keyboard.repeat_info");
     auto& self = *std::bit_cast<Keyboard*>(data);
     self.callbacks->on_wl_keyboard_repeat_info(rate, delay);
 }
@@ -1,10 +1,18 @@
 #include "layer-shell.hpp"
 #include "macros/assert.hpp"
+#include "trace.hpp"
 
 namespace towl {
-auto LayerSurface::configure(void* const data, zwlr_layer_surface_v1* const surface, const uint32_t serial, const uint32_t width, const uint32_t height) -> void {
-    zwlr_layer_surface_v1_ack_configure(surface, serial);
-    auto& self = *std::bit_cast<LayerSurface*>(data);
+auto LayerSurface::configure(void* const data, zwlr_layer_surface_v1* const /*surface*/, const uint32_t serial, const uint32_t width, const uint32_t height) -> void {
+    TOWL_TRACE_SCOPE("zwlr_layer_surface_v1.configure");
+    auto& self   = *std::bit_cast<LayerSurface*>(data);
+    self.serial  = serial;
+    self.width   = width;
+    self.height  = height;
+    self.unacked = true;
+    if(self.auto_ack) {
+        self.ack_configure();
+    }
     self.callbacks->on_zwlr_layer_surface_configure(width, height);
 }
 
@@ -29,6 +37,32 @@ auto LayerSurface::set_margin(const int32_t top, const int32_t right, const int3
     zwlr_layer_surface_v1_set_margin(surface.get(), top, right, bottom, left);
 }
 
+auto LayerSurface::get_width() const -> uint32_t {
+    return width;
+}
+
+auto LayerSurface::get_height() const -> uint32_t {
+    return height;
+}
+
+auto LayerSurface::set_auto_ack(const bool flag) -> void {
+    auto_ack = flag;
+}
+
+auto LayerSurface::ack_configure() -> bool {
+    if(!unacked) {
+        return false;
+    }
+    TOWL_TRACE_INSTANT("zwlr_layer_surface_v1.ack_configure", serial);
+    zwlr_layer_surface_v1_ack_configure(surface.get(), serial);
+    unacked = false;
+    return true;
+}
+
+auto LayerSurface::is_configure_pending() const -> bool {
+    return unacked;
+}
+
 auto LayerSurface::init(LayerSurfaceCallbacks* const callbacks) -> bool {
     ensure(surface != NULL);
     this->callbacks = callbacks;
@@ -23,6 +23,11 @@ class LayerSurface {
   private:
     impl::AutoNativeLayerSurface surface;
     LayerSurfaceCallbacks*       callbacks;
+    uint32_t                     serial   = 0;
+    uint32_t                     width    = 0;
+    uint32_t                     height   = 0;
+    bool                         unacked  = false;
+    bool                         auto_ack = true;
 
     static auto configure(void* data, zwlr_layer_surface_v1* surface, uint32_t serial, uint32_t width, uint32_t height) -> void;
     static auto closed(void* data, zwlr_layer_surface_v1* surface) -> void;
@@ -34,6 +39,13 @@ class LayerSurface {
     auto set_anchor(uint32_t anchor) -> void;
     auto set_exclusive_zone(int32_t zone) -> void;
     auto set_margin(int32_t top, int32_t right, int32_t bottom, int32_t left) -> void;
+    // size of the latest configure
+    auto get_width() const -> uint32_t;
+    auto get_height() const -> uint32_t;
+    // same as XDGSurface
+    auto set_auto_ack(bool flag) -> void;
+    auto ack_configure() -> bool;
+    auto is_configure_pending() const -> bool;
     auto init(LayerSurfaceCallbacks* callbacks) -> bool;
 
     LayerSurface() = default;
@@ -52,8 +64,15 @@ class LayerShell : public impl::Interface {
 
 // version = 1 ~ 4
 struct LayerShellBinder : impl::InterfaceBinder {
+    using Interface = LayerShell;
+
+    static constexpr auto interface_name = std::string_view("zwlr_layer_shell_v1");
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
 
     LayerShellBinder(const uint32_t version)
         : InterfaceBinder(version) {}
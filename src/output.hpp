@@ -64,10 +64,17 @@ class Output : public impl::Interface {
 
 // version = 1 ~ 4
 struct OutputBinder : impl::InterfaceBinder {
+    using Interface = Output;
+
+    static constexpr auto interface_name = std::string_view("wl_output");
+
     OutputCallbacks* callbacks;
 
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data, version, callbacks);
+    }
 
     OutputBinder(const uint32_t version, OutputCallbacks* callbacks)
         : InterfaceBinder(version),
@@ -1,4 +1,5 @@
 #include "pointer.hpp"
+#include "trace.hpp"
 
 namespace towl::impl {
 auto AutoNativePointerDeleter::operator()(wl_pointer* const pointer) -> void {
@@ -11,59 +12,229 @@ auto AutoNativePointerDeleter::operator()(wl_pointer* const pointer) -> void {
 } // namespace towl::impl
 
 namespace towl {
+auto PointerFrame::record_enter(const uint32_t serial, wl_surface* const surface, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    events |= Enter;
+    this->serial  = serial;
+    enter_surface = surface;
+    this->x       = wl_fixed_to_double(x);
+    this->y       = wl_fixed_to_double(y);
+}
+
+auto PointerFrame::record_leave(const uint32_t serial, wl_surface* const surface) -> void {
+    events |= Leave;
+    this->serial  = serial;
+    leave_surface = surface;
+}
+
+auto PointerFrame::record_motion(const uint32_t time, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    events |= Motion;
+    this->time = time;
+    this->x    = wl_fixed_to_double(x);
+    this->y    = wl_fixed_to_double(y);
+}
+
+auto PointerFrame::record_button(const uint32_t serial, const uint32_t time, const uint32_t button, const uint32_t state) -> bool {
+    if(button_count == max_buttons) {
+        return false;
+    }
+    events |= Button;
+    this->time            = time;
+    buttons[button_count] = {serial, time, button, state};
+    button_count += 1;
+    return true;
+}
+
+auto PointerFrame::record_axis(const uint32_t time, const uint32_t axis, const wl_fixed_t value) -> void {
+    if(axis >= axes.size()) {
+        return;
+    }
+    events |= Axis;
+    this->time = time;
+    axes[axis].value += wl_fixed_to_double(value);
+}
+
+auto PointerFrame::record_axis_source(const uint32_t source) -> void {
+    events |= AxisSource;
+    axis_source = source;
+}
+
+auto PointerFrame::record_axis_stop(const uint32_t time, const uint32_t axis) -> void {
+    if(axis >= axes.size()) {
+        return;
+    }
+    events |= AxisStop;
+    this->time      = time;
+    axes[axis].stop = true;
+}
+
+auto PointerFrame::record_axis_discrete(const uint32_t axis, const int32_t discrete) -> void {
+    if(axis >= axes.size()) {
+        return;
+    }
+    events |= AxisDiscrete;
+    axes[axis].discrete += discrete;
+}
+
+auto PointerFrame::record_axis_value120(const uint32_t axis, const int32_t value120) -> void {
+    if(axis >= axes.size()) {
+        return;
+    }
+    events |= AxisValue120;
+    axes[axis].value120 += value120;
+}
+
+auto PointerFrame::clear() -> void {
+    events       = 0;
+    axes         = {};
+    button_count = 0;
+}
+
 auto Pointer::enter(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*serial*/, wl_surface* const surface, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.enter");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_enter(surface, wl_fixed_to_double(x), wl_fixed_to_double(y));
 }
 
 auto Pointer::leave(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*serial*/, wl_surface* const surface) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.leave");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_leave(surface);
 }
 
 auto Pointer::motion(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*time*/, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.motion");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_motion(wl_fixed_to_double(x), wl_fixed_to_double(y));
 }
 
 auto Pointer::button(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*serial*/, const uint32_t /*time*/, const uint32_t button, const uint32_t state) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.button");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_button(button, state);
 }
 
 auto Pointer::axis(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*time*/, const uint32_t axis, const wl_fixed_t value) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.axis");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_axis(axis, wl_fixed_to_double(value));
 }
 
 auto Pointer::frame(void* const data, wl_pointer* const /*pointer*/) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.frame");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_frame();
 }
 
 auto Pointer::axis_source(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis_source) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.axis_source");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_axis_source(axis_source);
 }
 
 auto Pointer::axis_stop(void* const data, wl_pointer* const /*pointer*/, const uint32_t /*time*/, const uint32_t axis) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.axis_stop");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_axis_stop(axis);
 }
 
 auto Pointer::axis_descrete(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t descrete) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.axis_discrete");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_axis_discrete(axis, descrete);
 }
 
 auto Pointer::axis_value120(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t value120) -> void {
+    TOWL_TRACE_SCOPE("wl_pointer.axis_value120");
     auto& self = *std::bit_cast<Pointer*>(data);
     self.callbacks->on_wl_pointer_axis_value120(axis, value120);
 }
 
+auto Pointer::flush_frame() -> void {
+    if(pending.events == 0) {
+        return;
+    }
+    TOWL_TRACE_SCOPE("wl_pointer.frame");
+    frame_callbacks->on_wl_pointer_frame(pending);
+    pending.clear();
+}
+
+auto Pointer::end_event() -> void {
+    // servers older than version 5 do not send frame, so every event is a frame by itself
+    if(pointer.get_deleter().version < WL_POINTER_FRAME_SINCE_VERSION) {
+        flush_frame();
+    }
+}
+
+auto Pointer::aggregate_enter(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, wl_surface* const surface, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_enter(serial, surface, x, y);
+    self.end_event();
+}
+
+auto Pointer::aggregate_leave(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, wl_surface* const surface) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_leave(serial, surface);
+    self.end_event();
+}
+
+auto Pointer::aggregate_motion(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_motion(time, x, y);
+    self.end_event();
+}
+
+auto Pointer::aggregate_button(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, const uint32_t time, const uint32_t button, const uint32_t state) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    if(!self.pending.record_button(serial, time, button, state)) {
+        self.flush_frame();
+        self.pending.record_button(serial, time, button, state);
+    }
+    self.end_event();
+}
+
+auto Pointer::aggregate_axis(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const uint32_t axis, const wl_fixed_t value) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_axis(time, axis, value);
+    self.end_event();
+}
+
+auto Pointer::aggregate_frame(void* const data, wl_pointer* const /*pointer*/) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.flush_frame();
+}
+
+auto Pointer::aggregate_axis_source(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis_source) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_axis_source(axis_source);
+}
+
+auto Pointer::aggregate_axis_stop(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const uint32_t axis) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_axis_stop(time, axis);
+}
+
+auto Pointer::aggregate_axis_discrete(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t discrete) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_axis_discrete(axis, discrete);
+}
+
+auto Pointer::aggregate_axis_value120(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t value120) -> void {
+    auto& self = *std::bit_cast<Pointer*>(data);
+    self.pending.record_axis_value120(axis, value120);
+}
+
 Pointer::Pointer(wl_pointer* const pointer, const uint32_t version, PointerCallbacks* const callbacks)
     : pointer(pointer, {version}),
-      callbacks(callbacks) {
+      callbacks(callbacks),
+      frame_callbacks(nullptr) {
     wl_pointer_add_listener(pointer, &listener, this);
 };
+
+Pointer::Pointer(wl_pointer* const pointer, const uint32_t version, PointerFrameCallbacks* const callbacks)
+    : pointer(pointer, {version}),
+      callbacks(nullptr),
+      frame_callbacks(callbacks) {
+    pending.clear();
+    wl_pointer_add_listener(pointer, &aggregate_listener, this);
+};
 } // namespace towl
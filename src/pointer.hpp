@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 
 #include <wayland-client.h>
@@ -29,10 +30,72 @@ class PointerCallbacks {
     virtual ~PointerCallbacks(){};
 };
 
+// everything received between two wl_pointer.frame events
+struct PointerFrame {
+    enum Event : uint32_t {
+        Enter        = 1 << 0,
+        Leave        = 1 << 1,
+        Motion       = 1 << 2,
+        Button       = 1 << 3,
+        Axis         = 1 << 4,
+        AxisSource   = 1 << 5,
+        AxisStop     = 1 << 6,
+        AxisDiscrete = 1 << 7,
+        AxisValue120 = 1 << 8,
+    };
+
+    struct ButtonEvent {
+        uint32_t serial;
+        uint32_t time;
+        uint32_t button;
+        uint32_t state;
+    };
+
+    struct AxisEvent {
+        double  value;    // summed
+        int32_t discrete; // summed
+        int32_t value120; // summed
+        bool    stop;
+    };
+
+    static constexpr auto max_buttons = 8;
+
+    uint32_t                             events = 0;
+    uint32_t                             serial; // of enter or leave
+    uint32_t                             time;   // of the latest timestamped event
+    wl_surface*                          enter_surface;
+    wl_surface*                          leave_surface;
+    double                               x; // valid with Enter or Motion
+    double                               y;
+    std::array<AxisEvent, 2>             axes; // indexed by wl_pointer_axis
+    uint32_t                             axis_source;
+    std::array<ButtonEvent, max_buttons> buttons;
+    uint32_t                             button_count;
+
+    auto record_enter(uint32_t serial, wl_surface* surface, wl_fixed_t x, wl_fixed_t y) -> void;
+    auto record_leave(uint32_t serial, wl_surface* surface) -> void;
+    auto record_motion(uint32_t time, wl_fixed_t x, wl_fixed_t y) -> void;
+    auto record_button(uint32_t serial, uint32_t time, uint32_t button, uint32_t state) -> bool; // false if the frame is full
+    auto record_axis(uint32_t time, uint32_t axis, wl_fixed_t value) -> void;
+    auto record_axis_source(uint32_t source) -> void;
+    auto record_axis_stop(uint32_t time, uint32_t axis) -> void;
+    auto record_axis_discrete(uint32_t axis, int32_t discrete) -> void;
+    auto record_axis_value120(uint32_t axis, int32_t value120) -> void;
+    auto clear() -> void;
+};
+
+class PointerFrameCallbacks {
+  public:
+    virtual auto on_wl_pointer_frame(const PointerFrame& /*frame*/) -> void {}
+    virtual ~PointerFrameCallbacks(){};
+};
+
 class Pointer {
   private:
     impl::AutoNativePointer pointer;
     PointerCallbacks*       callbacks;
+    PointerFrameCallbacks*  frame_callbacks;
+    PointerFrame            pending;
 
     static auto enter(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface, wl_fixed_t x, wl_fixed_t y) -> void;
     static auto leave(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface) -> void;
@@ -48,7 +111,26 @@ class Pointer {
 
     static inline wl_pointer_listener listener = {enter, leave, motion, button, axis, frame, axis_source, axis_stop, axis_descrete, axis_value120, axis_relative_direction};
 
+    // aggregation mode
+    auto flush_frame() -> void;
+    auto end_event() -> void;
+
+    static auto aggregate_enter(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface, wl_fixed_t x, wl_fixed_t y) -> void;
+    static auto aggregate_leave(void* data, wl_pointer* pointer, uint32_t serial, wl_surface* surface) -> void;
+    static auto aggregate_motion(void* data, wl_pointer* pointer, uint32_t time, wl_fixed_t x, wl_fixed_t y) -> void;
+    static auto aggregate_button(void* data, wl_pointer* pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state) -> void;
+    static auto aggregate_axis(void* data, wl_pointer* pointer, uint32_t time, uint32_t axis, wl_fixed_t value) -> void;
+    static auto aggregate_frame(void* data, wl_pointer* pointer) -> void;
+    static auto aggregate_axis_source(void* data, wl_pointer* pointer, uint32_t axis_source) -> void;
+    static auto aggregate_axis_stop(void* data, wl_pointer* pointer, uint32_t time, uint32_t axis) -> void;
+    static auto aggregate_axis_discrete(void* data, wl_pointer* pointer, uint32_t axis, int32_t discrete) -> void;
+    static auto aggregate_axis_value120(void* data, wl_pointer* pointer, uint32_t axis, int32_t value120) -> void;
+
+    static inline wl_pointer_listener aggregate_listener = {aggregate_enter, aggregate_leave, aggregate_motion, aggregate_button, aggregate_axis, aggregate_frame, aggregate_axis_source, aggregate_axis_stop, aggregate_axis_discrete, aggregate_axis_value120, axis_relative_direction};
+
   public:
     Pointer(wl_pointer* pointer, uint32_t version, PointerCallbacks* callbacks);
+    // delivers one PointerFrame per wl_pointer.frame instead of individual events
+    Pointer(wl_pointer* pointer, uint32_t version, PointerFrameCallbacks* callbacks);
 };
 } // namespace towl
@@ -0,0 +1,147 @@
+#include <algorithm>
+
+#include "presentation.hpp"
+
+namespace towl {
+auto PresentationStats::add(const PresentationFeedback& feedback) -> void {
+    latencies[head] = feedback.get_latency();
+    head            = (head + 1) % latencies.size();
+    count           = std::min(count + 1, latencies.size());
+
+    if(const auto refresh = uint64_t(feedback.refresh); refresh != 0) {
+        // vblanks are on a grid through the previous presentation, the frame was due on the first one after commit
+        // without a previous presentation, that vblank is at most one refresh away
+        auto deadline = feedback.commit_time + refresh;
+        if(presented != 0 && last_time > feedback.commit_time) {
+            deadline = last_time - (last_time - feedback.commit_time - 1) / refresh * refresh;
+        } else if(presented != 0) {
+            deadline = last_time + ((feedback.commit_time - last_time) / refresh + 1) * refresh;
+        }
+        if(feedback.present_time > deadline) {
+            missed += (feedback.present_time - deadline + refresh / 2) / refresh;
+        }
+    }
+    last_time = feedback.present_time;
+    presented += 1;
+}
+
+auto PresentationStats::add_discarded() -> void {
+    discarded += 1;
+}
+
+auto PresentationStats::get_latency_percentile(const double p) -> uint64_t {
+    if(count == 0) {
+        return 0;
+    }
+    scratch.assign(latencies.begin(), latencies.begin() + count);
+    const auto rank = size_t(std::clamp(p, 0.0, 100.0) / 100.0 * double(count - 1) + 0.5);
+    std::nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+    return scratch[rank];
+}
+
+auto PresentationStats::get_sample_count() const -> size_t {
+    return count;
+}
+
+auto PresentationStats::get_missed_count() const -> uint64_t {
+    return missed;
+}
+
+auto PresentationStats::get_discarded_count() const -> uint64_t {
+    return discarded;
+}
+
+auto PresentationStats::get_presented_count() const -> uint64_t {
+    return presented;
+}
+
+auto PresentationStats::clear() -> void {
+    head      = 0;
+    count     = 0;
+    last_time = 0;
+    missed    = 0;
+    discarded = 0;
+    presented = 0;
+}
+
+PresentationStats::PresentationStats(const size_t window)
+    : latencies(std::max(window, size_t(1))) {
+    scratch.reserve(latencies.size());
+}
+
+auto Presentation::clock_id_callback(void* const data, wp_presentation* const /*presentation*/, const uint32_t clk_id) -> void {
+    auto& self    = *std::bit_cast<Presentation*>(data);
+    self.clock_id = clockid_t(clk_id);
+}
+
+auto Presentation::sync_output(void* const data, struct wp_presentation_feedback* const /*feedback*/, wl_output* const output) -> void {
+    auto& self  = *std::bit_cast<Feedback*>(data);
+    self.output = output;
+}
+
+auto Presentation::presented(void* const data, struct wp_presentation_feedback* const /*feedback*/,
+                             const uint32_t tv_sec_hi, const uint32_t tv_sec_lo, const uint32_t tv_nsec,
+                             const uint32_t refresh,
+                             const uint32_t seq_hi, const uint32_t seq_lo,
+                             const uint32_t flags) -> void {
+    auto&      self = *std::bit_cast<Feedback*>(data);
+    const auto sec  = uint64_t(tv_sec_hi) << 32 | tv_sec_lo;
+    const auto info = PresentationFeedback{
+        .commit_time  = self.commit_time,
+        .present_time = sec * 1'000'000'000 + tv_nsec,
+        .refresh      = refresh,
+        .sequence     = uint64_t(seq_hi) << 32 | seq_lo,
+        .flags        = flags,
+        .output       = self.output,
+    };
+    const auto callbacks = self.callbacks;
+    self.parent->erase(&self);
+    callbacks->on_wp_presentation_presented(info);
+}
+
+auto Presentation::discarded(void* const data, struct wp_presentation_feedback* const /*feedback*/) -> void {
+    auto&      self      = *std::bit_cast<Feedback*>(data);
+    const auto callbacks = self.callbacks;
+    self.parent->erase(&self);
+    callbacks->on_wp_presentation_discarded();
+}
+
+auto Presentation::erase(Feedback* const feedback) -> void {
+    feedbacks.remove_if([feedback](const Feedback& f) { return &f == feedback; });
+}
+
+auto Presentation::get_clock_id() const -> clockid_t {
+    return clock_id;
+}
+
+auto Presentation::now() const -> uint64_t {
+    auto ts = timespec();
+    clock_gettime(clock_id, &ts);
+    return uint64_t(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+auto Presentation::commit(Surface& surface, PresentationCallbacks* const callbacks) -> void {
+    auto& feedback = feedbacks.emplace_back(Feedback{
+        .feedback    = impl::AutoNativePresentationFeedback(wp_presentation_feedback(presentation.get(), surface.native())),
+        .parent      = this,
+        .callbacks   = callbacks,
+        .commit_time = 0,
+    });
+    wp_presentation_feedback_add_listener(feedback.feedback.get(), &feedback_listener, &feedback);
+    feedback.commit_time = now();
+    surface.commit();
+}
+
+Presentation::Presentation(void* const data)
+    : presentation(std::bit_cast<wp_presentation*>(data)) {
+    wp_presentation_add_listener(presentation.get(), &listener, this);
+}
+
+auto PresentationBinder::get_interface_description() -> const wl_interface* {
+    return &wp_presentation_interface;
+}
+
+auto PresentationBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
+    return std::unique_ptr<impl::Interface>(new Presentation(data));
+}
+} // namespace towl
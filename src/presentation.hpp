@@ -0,0 +1,123 @@
+#pragma once
+#include <list>
+#include <vector>
+
+#include <presentation-time.h>
+#include <time.h>
+
+#include "compositor.hpp"
+#include "interface.hpp"
+#include "macros/autoptr.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativePresentation, wp_presentation, wp_presentation_destroy);
+// the wp_presentation_feedback request function hides the struct name
+declare_autoptr(NativePresentationFeedback, struct wp_presentation_feedback, wp_presentation_feedback_destroy);
+} // namespace towl::impl
+
+namespace towl {
+// all times are in nanoseconds of Presentation::get_clock_id()
+struct PresentationFeedback {
+    uint64_t   commit_time;  // right before wl_surface.commit, see Presentation::commit
+    uint64_t   present_time; // when the content turned to light
+    uint32_t   refresh;      // predicted refresh interval, 0 if unknown
+    uint64_t   sequence;     // vertical retrace counter, valid with kind_vsync
+    uint32_t   flags;        // wp_presentation_feedback_kind
+    wl_output* output;       // nullable
+
+    auto get_latency() const -> uint64_t {
+        return present_time - commit_time;
+    }
+};
+
+class PresentationCallbacks {
+  public:
+    virtual auto on_wp_presentation_presented(const PresentationFeedback& /*feedback*/) -> void {}
+    virtual auto on_wp_presentation_discarded() -> void {}
+    virtual ~PresentationCallbacks() {}
+};
+
+// rolling commit-to-present latency of the latest samples
+class PresentationStats {
+  private:
+    std::vector<uint64_t> latencies; // ring
+    std::vector<uint64_t> scratch;
+    size_t                head      = 0;
+    size_t                count     = 0;
+    uint64_t              last_time = 0;
+    uint64_t              missed    = 0;
+    uint64_t              discarded = 0;
+    uint64_t              presented = 0;
+
+  public:
+    auto add(const PresentationFeedback& feedback) -> void;
+    auto add_discarded() -> void;
+    // p in [0, 100], 0 if no samples
+    auto get_latency_percentile(double p) -> uint64_t;
+    auto get_sample_count() const -> size_t;
+    // refresh cycles between the first vblank after each commit and its presentation
+    // needs the refresh interval, feedbacks without it are not counted
+    auto get_missed_count() const -> uint64_t;
+    auto get_discarded_count() const -> uint64_t;
+    auto get_presented_count() const -> uint64_t;
+    auto clear() -> void;
+
+    PresentationStats(size_t window = 120);
+};
+
+class Presentation : public impl::Interface {
+  private:
+    struct Feedback {
+        impl::AutoNativePresentationFeedback feedback;
+        Presentation*                        parent;
+        PresentationCallbacks*               callbacks;
+        uint64_t                             commit_time;
+        wl_output*                           output = nullptr;
+    };
+
+    impl::AutoNativePresentation presentation;
+    clockid_t                    clock_id = CLOCK_MONOTONIC;
+    std::list<Feedback>          feedbacks;
+
+    static auto clock_id_callback(void* data, wp_presentation* presentation, uint32_t clk_id) -> void;
+
+    static inline wp_presentation_listener listener = {clock_id_callback};
+
+    static auto sync_output(void* data, struct wp_presentation_feedback* feedback, wl_output* output) -> void;
+    static auto presented(void* data, struct wp_presentation_feedback* feedback,
+                          uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+                          uint32_t refresh,
+                          uint32_t seq_hi, uint32_t seq_lo,
+                          uint32_t flags) -> void;
+    static auto discarded(void* data, struct wp_presentation_feedback* feedback) -> void;
+
+    static inline wp_presentation_feedback_listener feedback_listener = {sync_output, presented, discarded};
+
+    auto erase(Feedback* feedback) -> void;
+
+  public:
+    auto get_clock_id() const -> clockid_t;
+    // current time in the presentation clock
+    auto now() const -> uint64_t;
+    // requests feedback for surface and commits it
+    auto commit(Surface& surface, PresentationCallbacks* callbacks) -> void;
+
+    Presentation(void* data);
+};
+
+// version = 1
+struct PresentationBinder : impl::InterfaceBinder {
+    using Interface = Presentation;
+
+    static constexpr auto interface_name = std::string_view("wp_presentation");
+
+    auto get_interface_description() -> const wl_interface* override;
+    auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
+
+    PresentationBinder(const uint32_t version)
+        : InterfaceBinder(version) {}
+};
+} // namespace towl
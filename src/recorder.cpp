@@ -0,0 +1,858 @@
+#include <cstring>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "macros/assert.hpp"
+#include "recorder.hpp"
+
+namespace towl {
+namespace {
+// variable length arguments, stored as a 32bit size followed by the bytes
+struct Blob {
+    const void* data;
+    uint32_t    size;
+};
+
+auto append(std::vector<std::byte>& buffer, const void* const data, const size_t size) -> void {
+    const auto bytes = static_cast<const std::byte*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <class T>
+auto pack(std::vector<std::byte>& buffer, const T& value) -> void {
+    if constexpr(std::is_same_v<T, Blob>) {
+        append(buffer, &value.size, sizeof(value.size));
+        append(buffer, value.data, value.size);
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>);
+        append(buffer, &value, sizeof(T));
+    }
+}
+
+auto string_blob(const char* const str) -> Blob {
+    return str != nullptr ? Blob{str, uint32_t(strlen(str) + 1)} : Blob{"", 1};
+}
+
+class Unpacker {
+  private:
+    std::span<const std::byte> payload;
+    size_t                     offset = 0;
+    bool                       ok     = true;
+
+  public:
+    template <class T>
+    auto read() -> T {
+        auto value = T();
+        if(offset + sizeof(T) > payload.size()) {
+            ok = false;
+            return value;
+        }
+        memcpy(&value, payload.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    auto read_blob() -> std::span<const std::byte> {
+        const auto size = read<uint32_t>();
+        if(!ok || offset + size > payload.size()) {
+            ok = false;
+            return {};
+        }
+        const auto blob = payload.subspan(offset, size);
+        offset += size;
+        return blob;
+    }
+
+    auto read_string() -> const char* {
+        const auto blob = read_blob();
+        if(blob.empty() || blob.back() != std::byte(0)) {
+            ok = false;
+            return "";
+        }
+        return std::bit_cast<const char*>(blob.data());
+    }
+
+    auto is_ok() const -> bool {
+        return ok;
+    }
+
+    Unpacker(const std::span<const std::byte> payload)
+        : payload(payload) {}
+};
+
+auto write_all(const int fd, const std::byte* data, size_t size) -> bool {
+    while(size > 0) {
+        const auto ret = write(fd, data, size);
+        if(ret < 0 && errno == EINTR) {
+            continue;
+        }
+        ensure(ret > 0);
+        data += ret;
+        size -= ret;
+    }
+    return true;
+}
+
+auto read_all(const int fd, std::vector<std::byte>& data) -> bool {
+    auto st = (struct stat){};
+    ensure(fstat(fd, &st) == 0);
+    data.resize(st.st_size);
+    auto done = size_t(0);
+    while(done < data.size()) {
+        const auto ret = read(fd, data.data() + done, data.size() - done);
+        if(ret < 0 && errno == EINTR) {
+            continue;
+        }
+        ensure(ret > 0);
+        done += ret;
+    }
+    return true;
+}
+
+// keymaps are replayed from an anonymous file holding the recorded contents
+auto create_keymap_file(const std::span<const std::byte> contents) -> int {
+    const auto fd = memfd_create("towl-replay-keymap", MFD_CLOEXEC);
+    ensure(fd >= 0);
+    if(!write_all(fd, contents.data(), contents.size())) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+constexpr auto flush_threshold = size_t(64 * 1024);
+} // namespace
+
+template <class... Args>
+auto RecordingCallbacks::record(const recording::RecordType type, const Args&... args) -> void {
+    if(recorder->failed) {
+        return;
+    }
+    const auto now    = std::chrono::steady_clock::now() - recorder->start;
+    auto&      buffer = recorder->buffer;
+    const auto offset = buffer.size();
+    auto       header = recording::RecordHeader{
+              .time   = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+              .object = object,
+              .size   = 0,
+              .type   = type,
+    };
+    pack(buffer, header);
+    (pack(buffer, args), ...);
+    header.size = buffer.size() - offset - sizeof(header);
+    memcpy(buffer.data() + offset, &header, sizeof(header));
+    if(buffer.size() >= flush_threshold) {
+        recorder->flush();
+    }
+}
+
+auto RecordingCallbacks::on_wl_pointer_enter(wl_surface* const surface, const double x, const double y) -> void {
+    record(recording::RecordType::PointerEnter, recorder->get_handle(surface), x, y);
+    pointer->on_wl_pointer_enter(surface, x, y);
+}
+
+auto RecordingCallbacks::on_wl_pointer_motion(const double x, const double y) -> void {
+    record(recording::RecordType::PointerMotion, x, y);
+    pointer->on_wl_pointer_motion(x, y);
+}
+
+auto RecordingCallbacks::on_wl_pointer_leave(wl_surface* const surface) -> void {
+    record(recording::RecordType::PointerLeave, recorder->get_handle(surface));
+    pointer->on_wl_pointer_leave(surface);
+}
+
+auto RecordingCallbacks::on_wl_pointer_button(const uint32_t button, const uint32_t state) -> void {
+    record(recording::RecordType::PointerButton, button, state);
+    pointer->on_wl_pointer_button(button, state);
+}
+
+auto RecordingCallbacks::on_wl_pointer_axis(const uint32_t axis, const double value) -> void {
+    record(recording::RecordType::PointerAxis, axis, value);
+    pointer->on_wl_pointer_axis(axis, value);
+}
+
+auto RecordingCallbacks::on_wl_pointer_frame() -> void {
+    record(recording::RecordType::PointerFrame);
+    pointer->on_wl_pointer_frame();
+}
+
+auto RecordingCallbacks::on_wl_pointer_axis_source(const uint32_t source) -> void {
+    record(recording::RecordType::PointerAxisSource, source);
+    pointer->on_wl_pointer_axis_source(source);
+}
+
+auto RecordingCallbacks::on_wl_pointer_axis_stop(const uint32_t axis) -> void {
+    record(recording::RecordType::PointerAxisStop, axis);
+    pointer->on_wl_pointer_axis_stop(axis);
+}
+
+auto RecordingCallbacks::on_wl_pointer_axis_discrete(const uint32_t axis, const int32_t discrete) -> void {
+    record(recording::RecordType::PointerAxisDiscrete, axis, discrete);
+    pointer->on_wl_pointer_axis_discrete(axis, discrete);
+}
+
+auto RecordingCallbacks::on_wl_pointer_axis_value120(const uint32_t axis, const int32_t value120) -> void {
+    record(recording::RecordType::PointerAxisValue120, axis, value120);
+    pointer->on_wl_pointer_axis_value120(axis, value120);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_keymap(const uint32_t format, const int32_t fd, const uint32_t size) -> void {
+    // store the contents, the fd itself is meaningless in another session
+    const auto map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map != MAP_FAILED) {
+        record(recording::RecordType::KeyboardKeymap, format, Blob{map, size});
+        munmap(map, size);
+    } else {
+        record(recording::RecordType::KeyboardKeymap, format, Blob{nullptr, 0});
+    }
+    keyboard->on_wl_keyboard_keymap(format, fd, size);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_enter(wl_surface* const surface, const Array<uint32_t>& keys) -> void {
+    record(recording::RecordType::KeyboardEnter, recorder->get_handle(surface), Blob{keys.data, uint32_t(keys.size * sizeof(uint32_t))});
+    keyboard->on_wl_keyboard_enter(surface, keys);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_leave(wl_surface* const surface) -> void {
+    record(recording::RecordType::KeyboardLeave, recorder->get_handle(surface));
+    keyboard->on_wl_keyboard_leave(surface);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_key(const uint32_t key, const uint32_t state) -> void {
+    record(recording::RecordType::KeyboardKey, key, state);
+    keyboard->on_wl_keyboard_key(key, state);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_modifiers(const uint32_t mods_depressed, const uint32_t mods_latched, const uint32_t mods_locked, const uint32_t group) -> void {
+    record(recording::RecordType::KeyboardModifiers, mods_depressed, mods_latched, mods_locked, group);
+    keyboard->on_wl_keyboard_modifiers(mods_depressed, mods_latched, mods_locked, group);
+}
+
+auto RecordingCallbacks::on_wl_keyboard_repeat_info(const int32_t rate, const int32_t delay) -> void {
+    record(recording::RecordType::KeyboardRepeatInfo, rate, delay);
+    keyboard->on_wl_keyboard_repeat_info(rate, delay);
+}
+
+auto RecordingCallbacks::on_wl_touch_down(wl_surface* const surface, const uint32_t id, const double x, const double y) -> void {
+    record(recording::RecordType::TouchDown, recorder->get_handle(surface), id, x, y);
+    touch->on_wl_touch_down(surface, id, x, y);
+}
+
+auto RecordingCallbacks::on_wl_touch_motion(const uint32_t id, const double x, const double y) -> void {
+    record(recording::RecordType::TouchMotion, id, x, y);
+    touch->on_wl_touch_motion(id, x, y);
+}
+
+auto RecordingCallbacks::on_wl_touch_up(const uint32_t id) -> void {
+    record(recording::RecordType::TouchUp, id);
+    touch->on_wl_touch_up(id);
+}
+
+auto RecordingCallbacks::on_wl_touch_frame() -> void {
+    record(recording::RecordType::TouchFrame);
+    touch->on_wl_touch_frame();
+}
+
+auto RecordingCallbacks::on_wl_surface_enter(wl_output* const output) -> void {
+    record(recording::RecordType::SurfaceEnter, recorder->get_handle(output));
+    surface->on_wl_surface_enter(output);
+}
+
+auto RecordingCallbacks::on_wl_surface_leave(wl_output* const output) -> void {
+    record(recording::RecordType::SurfaceLeave, recorder->get_handle(output));
+    surface->on_wl_surface_leave(output);
+}
+
+auto RecordingCallbacks::on_wl_surface_preferred_buffer_scale(const int32_t factor) -> void {
+    record(recording::RecordType::SurfacePreferredBufferScale, factor);
+    surface->on_wl_surface_preferred_buffer_scale(factor);
+}
+
+auto RecordingCallbacks::on_wl_surface_preferred_buffer_transform(const uint32_t transform) -> void {
+    record(recording::RecordType::SurfacePreferredBufferTransform, transform);
+    surface->on_wl_surface_preferred_buffer_transform(transform);
+}
+
+auto RecordingCallbacks::on_wl_surface_frame() -> void {
+    record(recording::RecordType::SurfaceFrame);
+    surface->on_wl_surface_frame();
+}
+
+auto RecordingCallbacks::on_wl_surface_visibility(const bool visible) -> void {
+    record(recording::RecordType::SurfaceVisibility, uint8_t(visible));
+    surface->on_wl_surface_visibility(visible);
+}
+
+auto RecordingCallbacks::on_wl_output_created(wl_output* const output) -> void {
+    record(recording::RecordType::OutputCreated, recorder->get_handle(output));
+    this->output->on_wl_output_created(output);
+}
+
+auto RecordingCallbacks::on_wl_output_removed(wl_output* const output) -> void {
+    record(recording::RecordType::OutputRemoved, recorder->get_handle(output));
+    this->output->on_wl_output_removed(output);
+}
+
+auto RecordingCallbacks::on_wl_output_geometry(wl_output* const output, const int32_t x, const int32_t y, const int32_t physical_width, const int32_t physical_height, const int32_t subpixel, const char* const make, const char* const model, const int32_t transform) -> void {
+    record(recording::RecordType::OutputGeometry, recorder->get_handle(output), x, y, physical_width, physical_height, subpixel, transform, string_blob(make), string_blob(model));
+    this->output->on_wl_output_geometry(output, x, y, physical_width, physical_height, subpixel, make, model, transform);
+}
+
+auto RecordingCallbacks::on_wl_output_mode(wl_output* const output, const uint32_t flags, const int32_t width, const int32_t height, const int32_t refresh) -> void {
+    record(recording::RecordType::OutputMode, recorder->get_handle(output), flags, width, height, refresh);
+    this->output->on_wl_output_mode(output, flags, width, height, refresh);
+}
+
+auto RecordingCallbacks::on_wl_output_done(wl_output* const output) -> void {
+    record(recording::RecordType::OutputDone, recorder->get_handle(output));
+    this->output->on_wl_output_done(output);
+}
+
+auto RecordingCallbacks::on_wl_output_scale(wl_output* const output, const int32_t scale) -> void {
+    record(recording::RecordType::OutputScale, recorder->get_handle(output), scale);
+    this->output->on_wl_output_scale(output, scale);
+}
+
+auto RecordingCallbacks::on_wl_output_name(wl_output* const output, const char* const name) -> void {
+    record(recording::RecordType::OutputName, recorder->get_handle(output), string_blob(name));
+    this->output->on_wl_output_name(output, name);
+}
+
+auto RecordingCallbacks::on_wl_output_description(wl_output* const output, const char* const description) -> void {
+    record(recording::RecordType::OutputDescription, recorder->get_handle(output), string_blob(description));
+    this->output->on_wl_output_description(output, description);
+}
+
+auto RecordingCallbacks::on_xdg_surface_configure() -> void {
+    record(recording::RecordType::XDGSurfaceConfigure);
+    xdg_surface->on_xdg_surface_configure();
+}
+
+auto RecordingCallbacks::on_xdg_toplevel_configure(const XDGToplevelState& state) -> void {
+    record(recording::RecordType::XDGToplevelConfigure, state.width, state.height, state.states, state.bounds_width, state.bounds_height);
+    xdg_toplevel->on_xdg_toplevel_configure(state);
+}
+
+auto RecordingCallbacks::on_xdg_toplevel_close() -> void {
+    record(recording::RecordType::XDGToplevelClose);
+    xdg_toplevel->on_xdg_toplevel_close();
+}
+
+auto RecordingCallbacks::on_zwlr_layer_surface_configure(const uint32_t width, const uint32_t height) -> void {
+    record(recording::RecordType::LayerSurfaceConfigure, width, height);
+    layer->on_zwlr_layer_surface_configure(width, height);
+}
+
+auto RecordingCallbacks::on_zwlr_layer_surface_closed() -> void {
+    record(recording::RecordType::LayerSurfaceClosed);
+    layer->on_zwlr_layer_surface_closed();
+}
+
+RecordingCallbacks::RecordingCallbacks(Recorder* const recorder, const uint32_t object)
+    : recorder(recorder),
+      object(object) {}
+
+auto Recorder::get_handle(void* const ptr) -> uint32_t {
+    if(ptr == nullptr) {
+        return 0;
+    }
+    for(auto i = 0uz; i < handles.size(); i += 1) {
+        if(handles[i] == ptr) {
+            return i + 1;
+        }
+    }
+    handles.push_back(ptr);
+    return handles.size();
+}
+
+auto Recorder::create_proxy() -> RecordingCallbacks& {
+    return *proxies.emplace_back(new RecordingCallbacks(this, proxies.size() + 1));
+}
+
+auto Recorder::wrap(PointerCallbacks* const callbacks) -> PointerCallbacks* {
+    auto& proxy   = create_proxy();
+    proxy.pointer = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(KeyboardCallbacks* const callbacks) -> KeyboardCallbacks* {
+    auto& proxy    = create_proxy();
+    proxy.keyboard = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(TouchCallbacks* const callbacks) -> TouchCallbacks* {
+    auto& proxy = create_proxy();
+    proxy.touch = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(SurfaceCallbacks* const callbacks) -> SurfaceCallbacks* {
+    auto& proxy   = create_proxy();
+    proxy.surface = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(OutputCallbacks* const callbacks) -> OutputCallbacks* {
+    auto& proxy  = create_proxy();
+    proxy.output = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(XDGSurfaceCallbacks* const callbacks) -> XDGSurfaceCallbacks* {
+    auto& proxy       = create_proxy();
+    proxy.xdg_surface = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(XDGToplevelCallbacks* const callbacks) -> XDGToplevelCallbacks* {
+    auto& proxy        = create_proxy();
+    proxy.xdg_toplevel = callbacks;
+    return &proxy;
+}
+
+auto Recorder::wrap(LayerSurfaceCallbacks* const callbacks) -> LayerSurfaceCallbacks* {
+    auto& proxy = create_proxy();
+    proxy.layer = callbacks;
+    return &proxy;
+}
+
+auto Recorder::flush() -> bool {
+    if(failed || fd < 0) {
+        buffer.clear();
+        return false;
+    }
+    failed = !write_all(fd, buffer.data(), buffer.size());
+    buffer.clear();
+    return !failed;
+}
+
+auto Recorder::is_ok() const -> bool {
+    return !failed;
+}
+
+auto Recorder::open(const char* const path) -> bool {
+    fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    ensure(fd >= 0, "failed to open {}", path);
+    start  = std::chrono::steady_clock::now();
+    failed = false;
+    buffer.clear();
+    append(buffer, recording::magic.data(), recording::magic.size());
+    return flush();
+}
+
+Recorder::~Recorder() {
+    if(fd >= 0) {
+        flush();
+        close(fd);
+    }
+}
+
+auto Replayer::get_targets(const uint32_t object) -> Targets& {
+    if(targets.size() <= object) {
+        targets.resize(object + 1);
+    }
+    return targets[object];
+}
+
+auto Replayer::get_handle(const uint32_t id) const -> void* {
+    return id < handles.size() ? handles[id] : nullptr;
+}
+
+auto Replayer::dispatch(const recording::RecordHeader& header, const std::span<const std::byte> payload) -> bool {
+    using enum recording::RecordType;
+
+    if(header.object >= targets.size()) {
+        return true; // unbound object
+    }
+    auto& t = targets[header.object];
+    auto  u = Unpacker(payload);
+
+    const auto surface_arg = [&]() { return std::bit_cast<wl_surface*>(get_handle(u.read<uint32_t>())); };
+    const auto output_arg  = [&]() { return std::bit_cast<wl_output*>(get_handle(u.read<uint32_t>())); };
+
+    // arguments are evaluated in order through braced initialization
+    switch(header.type) {
+    case PointerEnter:
+    case PointerLeave:
+    case PointerMotion:
+    case PointerButton:
+    case PointerAxis:
+    case PointerFrame:
+    case PointerAxisSource:
+    case PointerAxisStop:
+    case PointerAxisDiscrete:
+    case PointerAxisValue120: {
+        if(t.pointer == nullptr) {
+            return true;
+        }
+        switch(header.type) {
+        case PointerEnter: {
+            const auto [surface, x, y] = std::tuple{surface_arg(), u.read<double>(), u.read<double>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_enter(surface, x, y);
+        } break;
+        case PointerLeave: {
+            const auto surface = surface_arg();
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_leave(surface);
+        } break;
+        case PointerMotion: {
+            const auto [x, y] = std::tuple{u.read<double>(), u.read<double>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_motion(x, y);
+        } break;
+        case PointerButton: {
+            const auto [button, state] = std::tuple{u.read<uint32_t>(), u.read<uint32_t>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_button(button, state);
+        } break;
+        case PointerAxis: {
+            const auto [axis, value] = std::tuple{u.read<uint32_t>(), u.read<double>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_axis(axis, value);
+        } break;
+        case PointerFrame:
+            t.pointer->on_wl_pointer_frame();
+            break;
+        case PointerAxisSource: {
+            const auto source = u.read<uint32_t>();
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_axis_source(source);
+        } break;
+        case PointerAxisStop: {
+            const auto axis = u.read<uint32_t>();
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_axis_stop(axis);
+        } break;
+        case PointerAxisDiscrete: {
+            const auto [axis, discrete] = std::tuple{u.read<uint32_t>(), u.read<int32_t>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_axis_discrete(axis, discrete);
+        } break;
+        case PointerAxisValue120: {
+            const auto [axis, value120] = std::tuple{u.read<uint32_t>(), u.read<int32_t>()};
+            ensure(u.is_ok());
+            t.pointer->on_wl_pointer_axis_value120(axis, value120);
+        } break;
+        default:
+            break;
+        }
+    } break;
+    case KeyboardKeymap:
+    case KeyboardEnter:
+    case KeyboardLeave:
+    case KeyboardKey:
+    case KeyboardModifiers:
+    case KeyboardRepeatInfo: {
+        if(t.keyboard == nullptr) {
+            return true;
+        }
+        switch(header.type) {
+        case KeyboardKeymap: {
+            const auto [format, contents] = std::tuple{u.read<uint32_t>(), u.read_blob()};
+            ensure(u.is_ok());
+            const auto fd = create_keymap_file(contents);
+            ensure(fd >= 0);
+            t.keyboard->on_wl_keyboard_keymap(format, fd, contents.size());
+        } break;
+        case KeyboardEnter: {
+            const auto [surface, keys] = std::tuple{surface_arg(), u.read_blob()};
+            ensure(u.is_ok());
+            // copy into an aligned array, the payload has no alignment guarantee
+            auto storage = std::vector<uint32_t>(keys.size() / sizeof(uint32_t));
+            memcpy(storage.data(), keys.data(), storage.size() * sizeof(uint32_t));
+            const auto array = wl_array{.size = storage.size() * sizeof(uint32_t), .alloc = 0, .data = storage.data()};
+            t.keyboard->on_wl_keyboard_enter(surface, Array<uint32_t>(array));
+        } break;
+        case KeyboardLeave: {
+            const auto surface = surface_arg();
+            ensure(u.is_ok());
+            t.keyboard->on_wl_keyboard_leave(surface);
+        } break;
+        case KeyboardKey: {
+            const auto [key, state] = std::tuple{u.read<uint32_t>(), u.read<uint32_t>()};
+            ensure(u.is_ok());
+            t.keyboard->on_wl_keyboard_key(key, state);
+        } break;
+        case KeyboardModifiers: {
+            const auto [depressed, latched, locked, group] = std::tuple{u.read<uint32_t>(), u.read<uint32_t>(), u.read<uint32_t>(), u.read<uint32_t>()};
+            ensure(u.is_ok());
+            t.keyboard->on_wl_keyboard_modifiers(depressed, latched, locked, group);
+        } break;
+        case KeyboardRepeatInfo: {
+            const auto [rate, delay] = std::tuple{u.read<int32_t>(), u.read<int32_t>()};
+            ensure(u.is_ok());
+            t.keyboard->on_wl_keyboard_repeat_info(rate, delay);
+        } break;
+        default:
+            break;
+        }
+    } break;
+    case TouchDown:
+    case TouchMotion:
+    case TouchUp:
+    case TouchFrame: {
+        if(t.touch == nullptr) {
+            return true;
+        }
+        switch(header.type) {
+        case TouchDown: {
+            const auto [surface, id, x, y] = std::tuple{surface_arg(), u.read<uint32_t>(), u.read<double>(), u.read<double>()};
+            ensure(u.is_ok());
+            t.touch->on_wl_touch_down(surface, id, x, y);
+        } break;
+        case TouchMotion: {
+            const auto [id, x, y] = std::tuple{u.read<uint32_t>(), u.read<double>(), u.read<double>()};
+            ensure(u.is_ok());
+            t.touch->on_wl_touch_motion(id, x, y);
+        } break;
+        case TouchUp: {
+            const auto id = u.read<uint32_t>();
+            ensure(u.is_ok());
+            t.touch->on_wl_touch_up(id);
+        } break;
+        case TouchFrame:
+            t.touch->on_wl_touch_frame();
+            break;
+        default:
+            break;
+        }
+    } break;
+    case SurfaceEnter:
+    case SurfaceLeave:
+    case SurfacePreferredBufferScale:
+    case SurfacePreferredBufferTransform:
+    case SurfaceFrame:
+    case SurfaceVisibility: {
+        if(t.surface == nullptr) {
+            return true;
+        }
+        switch(header.type) {
+        case SurfaceEnter: {
+            const auto output = output_arg();
+            ensure(u.is_ok());
+            t.surface->on_wl_surface_enter(output);
+        } break;
+        case SurfaceLeave: {
+            const auto output = output_arg();
+            ensure(u.is_ok());
+            t.surface->on_wl_surface_leave(output);
+        } break;
+        case SurfacePreferredBufferScale: {
+            const auto factor = u.read<int32_t>();
+            ensure(u.is_ok());
+            t.surface->on_wl_surface_preferred_buffer_scale(factor);
+        } break;
+        case SurfacePreferredBufferTransform: {
+            const auto transform = u.read<uint32_t>();
+            ensure(u.is_ok());
+            t.surface->on_wl_surface_preferred_buffer_transform(transform);
+        } break;
+        case SurfaceFrame:
+            t.surface->on_wl_surface_frame();
+            break;
+        case SurfaceVisibility: {
+            const auto visible = u.read<uint8_t>();
+            ensure(u.is_ok());
+            t.surface->on_wl_surface_visibility(visible != 0);
+        } break;
+        default:
+            break;
+        }
+    } break;
+    case OutputCreated:
+    case OutputRemoved:
+    case OutputGeometry:
+    case OutputMode:
+    case OutputDone:
+    case OutputScale:
+    case OutputName:
+    case OutputDescription: {
+        if(t.output == nullptr) {
+            return true;
+        }
+        const auto output = output_arg();
+        switch(header.type) {
+        case OutputCreated:
+            ensure(u.is_ok());
+            t.output->on_wl_output_created(output);
+            break;
+        case OutputRemoved:
+            ensure(u.is_ok());
+            t.output->on_wl_output_removed(output);
+            break;
+        case OutputGeometry: {
+            const auto [x, y, physical_width, physical_height, subpixel, transform] = std::tuple{u.read<int32_t>(), u.read<int32_t>(), u.read<int32_t>(), u.read<int32_t>(), u.read<int32_t>(), u.read<int32_t>()};
+            const auto [make, model]                                                = std::tuple{u.read_string(), u.read_string()};
+            ensure(u.is_ok());
+            t.output->on_wl_output_geometry(output, x, y, physical_width, physical_height, subpixel, make, model, transform);
+        } break;
+        case OutputMode: {
+            const auto [flags, width, height, refresh] = std::tuple{u.read<uint32_t>(), u.read<int32_t>(), u.read<int32_t>(), u.read<int32_t>()};
+            ensure(u.is_ok());
+            t.output->on_wl_output_mode(output, flags, width, height, refresh);
+        } break;
+        case OutputDone:
+            ensure(u.is_ok());
+            t.output->on_wl_output_done(output);
+            break;
+        case OutputScale: {
+            const auto scale = u.read<int32_t>();
+            ensure(u.is_ok());
+            t.output->on_wl_output_scale(output, scale);
+        } break;
+        case OutputName: {
+            const auto name = u.read_string();
+            ensure(u.is_ok());
+            t.output->on_wl_output_name(output, name);
+        } break;
+        case OutputDescription: {
+            const auto description = u.read_string();
+            ensure(u.is_ok());
+            t.output->on_wl_output_description(output, description);
+        } break;
+        default:
+            break;
+        }
+    } break;
+    case XDGSurfaceConfigure:
+        if(t.xdg_surface != nullptr) {
+            t.xdg_surface->on_xdg_surface_configure();
+        }
+        break;
+    case XDGToplevelConfigure:
+    case XDGToplevelClose: {
+        if(t.xdg_toplevel == nullptr) {
+            return true;
+        }
+        if(header.type == XDGToplevelClose) {
+            t.xdg_toplevel->on_xdg_toplevel_close();
+            break;
+        }
+        const auto state = XDGToplevelState{
+            .width         = u.read<int32_t>(),
+            .height        = u.read<int32_t>(),
+            .states        = u.read<uint32_t>(),
+            .bounds_width  = u.read<int32_t>(),
+            .bounds_height = u.read<int32_t>(),
+        };
+        ensure(u.is_ok());
+        t.xdg_toplevel->on_xdg_toplevel_configure(state);
+    } break;
+    case LayerSurfaceConfigure:
+    case LayerSurfaceClosed: {
+        if(t.layer == nullptr) {
+            return true;
+        }
+        if(header.type == LayerSurfaceClosed) {
+            t.layer->on_zwlr_layer_surface_closed();
+            break;
+        }
+        const auto [width, height] = std::tuple{u.read<uint32_t>(), u.read<uint32_t>()};
+        ensure(u.is_ok());
+        t.layer->on_zwlr_layer_surface_configure(width, height);
+    } break;
+    default:
+        // records from a newer version are skipped
+        break;
+    }
+    return true;
+}
+
+auto Replayer::bind(const uint32_t object, PointerCallbacks* const callbacks) -> void {
+    get_targets(object).pointer = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, KeyboardCallbacks* const callbacks) -> void {
+    get_targets(object).keyboard = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, TouchCallbacks* const callbacks) -> void {
+    get_targets(object).touch = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, SurfaceCallbacks* const callbacks) -> void {
+    get_targets(object).surface = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, OutputCallbacks* const callbacks) -> void {
+    get_targets(object).output = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, XDGSurfaceCallbacks* const callbacks) -> void {
+    get_targets(object).xdg_surface = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, XDGToplevelCallbacks* const callbacks) -> void {
+    get_targets(object).xdg_toplevel = callbacks;
+}
+
+auto Replayer::bind(const uint32_t object, LayerSurfaceCallbacks* const callbacks) -> void {
+    get_targets(object).layer = callbacks;
+}
+
+auto Replayer::bind_handle(const uint32_t id, void* const ptr) -> void {
+    if(handles.size() <= id) {
+        handles.resize(id + 1);
+    }
+    handles[id] = ptr;
+}
+
+auto Replayer::step() -> bool {
+    if(is_finished()) {
+        return false;
+    }
+    auto header = recording::RecordHeader();
+    ensure(cursor + sizeof(header) <= data.size(), "truncated record header");
+    memcpy(&header, data.data() + cursor, sizeof(header));
+    ensure(cursor + sizeof(header) + header.size <= data.size(), "truncated record payload");
+    const auto payload = std::span(data).subspan(cursor + sizeof(header), header.size);
+    cursor += sizeof(header) + header.size;
+    ensure(dispatch(header, payload), "malformed record");
+    return true;
+}
+
+auto Replayer::replay(const bool realtime) -> bool {
+    // timing is relative to the first replayed record, which may be in the middle of the trace
+    auto start = std::optional<std::pair<std::chrono::steady_clock::time_point, uint64_t>>();
+    while(!is_finished()) {
+        if(realtime) {
+            auto header = recording::RecordHeader();
+            ensure(cursor + sizeof(header) <= data.size(), "truncated record header");
+            memcpy(&header, data.data() + cursor, sizeof(header));
+            if(!start) {
+                start.emplace(std::chrono::steady_clock::now(), header.time);
+            }
+            std::this_thread::sleep_until(start->first + std::chrono::nanoseconds(header.time - start->second));
+        }
+        ensure(step());
+    }
+    return true;
+}
+
+auto Replayer::rewind() -> void {
+    cursor = recording::magic.size();
+}
+
+auto Replayer::is_finished() const -> bool {
+    return cursor >= data.size();
+}
+
+auto Replayer::open(const char* const path) -> bool {
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    ensure(fd >= 0, "failed to open {}", path);
+    const auto ok = read_all(fd, data);
+    close(fd);
+    ensure(ok, "failed to read {}", path);
+    ensure(data.size() >= recording::magic.size() && memcmp(data.data(), recording::magic.data(), recording::magic.size()) == 0, "{} is not a towl trace", path);
+    rewind();
+    return true;
+}
+} // namespace towl
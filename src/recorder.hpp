@@ -0,0 +1,248 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "compositor.hpp"
+#include "keyboard.hpp"
+#include "layer-shell.hpp"
+#include "output.hpp"
+#include "pointer.hpp"
+#include "touch.hpp"
+#include "xdg-wm-base.hpp"
+
+namespace towl::recording {
+// file layout: magic, then records of RecordHeader followed by size bytes of packed arguments
+constexpr auto magic = std::string_view("TOWLREC1");
+
+enum class RecordType : uint16_t {
+    PointerEnter,
+    PointerLeave,
+    PointerMotion,
+    PointerButton,
+    PointerAxis,
+    PointerFrame,
+    PointerAxisSource,
+    PointerAxisStop,
+    PointerAxisDiscrete,
+    PointerAxisValue120,
+    KeyboardKeymap,
+    KeyboardEnter,
+    KeyboardLeave,
+    KeyboardKey,
+    KeyboardModifiers,
+    KeyboardRepeatInfo,
+    TouchDown,
+    TouchMotion,
+    TouchUp,
+    TouchFrame,
+    SurfaceEnter,
+    SurfaceLeave,
+    SurfacePreferredBufferScale,
+    SurfacePreferredBufferTransform,
+    SurfaceFrame,
+    SurfaceVisibility,
+    OutputCreated,
+    OutputRemoved,
+    OutputGeometry,
+    OutputMode,
+    OutputDone,
+    OutputScale,
+    OutputName,
+    OutputDescription,
+    XDGSurfaceConfigure,
+    XDGToplevelConfigure,
+    XDGToplevelClose,
+    LayerSurfaceConfigure,
+    LayerSurfaceClosed,
+};
+
+// written as is, every byte is a named member so that no uninitialized padding reaches the file
+struct RecordHeader {
+    uint64_t   time; // nanoseconds since the recorder was created
+    uint32_t   object;
+    uint32_t   size;
+    RecordType type;
+    uint16_t   reserved = 0;
+    uint32_t   padding  = 0;
+};
+static_assert(sizeof(RecordHeader) == 24);
+} // namespace towl::recording
+
+namespace towl {
+class Recorder;
+
+// forwards every callback to the wrapped callbacks after logging it
+// only the interface the proxy was created for is forwarded
+class RecordingCallbacks : public PointerCallbacks,
+                           public KeyboardCallbacks,
+                           public TouchCallbacks,
+                           public SurfaceCallbacks,
+                           public OutputCallbacks,
+                           public XDGSurfaceCallbacks,
+                           public XDGToplevelCallbacks,
+                           public LayerSurfaceCallbacks {
+  private:
+    friend class Recorder;
+
+    Recorder*              recorder;
+    uint32_t               object;
+    PointerCallbacks*      pointer      = nullptr;
+    KeyboardCallbacks*     keyboard     = nullptr;
+    TouchCallbacks*        touch        = nullptr;
+    SurfaceCallbacks*      surface      = nullptr;
+    OutputCallbacks*       output       = nullptr;
+    XDGSurfaceCallbacks*   xdg_surface  = nullptr;
+    XDGToplevelCallbacks*  xdg_toplevel = nullptr;
+    LayerSurfaceCallbacks* layer        = nullptr;
+
+    template <class... Args>
+    auto record(recording::RecordType type, const Args&... args) -> void;
+
+  public:
+    // PointerCallbacks
+    auto on_wl_pointer_enter(wl_surface* surface, double x, double y) -> void override;
+    auto on_wl_pointer_motion(double x, double y) -> void override;
+    auto on_wl_pointer_leave(wl_surface* surface) -> void override;
+    auto on_wl_pointer_button(uint32_t button, uint32_t state) -> void override;
+    auto on_wl_pointer_axis(uint32_t axis, double value) -> void override;
+    auto on_wl_pointer_frame() -> void override;
+    auto on_wl_pointer_axis_source(uint32_t source) -> void override;
+    auto on_wl_pointer_axis_stop(uint32_t axis) -> void override;
+    auto on_wl_pointer_axis_discrete(uint32_t axis, int32_t discrete) -> void override;
+    auto on_wl_pointer_axis_value120(uint32_t axis, int32_t value120) -> void override;
+
+    // KeyboardCallbacks
+    auto on_wl_keyboard_keymap(uint32_t format, int32_t fd, uint32_t size) -> void override;
+    auto on_wl_keyboard_enter(wl_surface* surface, const Array<uint32_t>& keys) -> void override;
+    auto on_wl_keyboard_leave(wl_surface* surface) -> void override;
+    auto on_wl_keyboard_key(uint32_t key, uint32_t state) -> void override;
+    auto on_wl_keyboard_modifiers(uint32_t mods_depressed, uint32_t mods_latched, uint32_t mods_locked, uint32_t group) -> void override;
+    auto on_wl_keyboard_repeat_info(int32_t rate, int32_t delay) -> void override;
+
+    // TouchCallbacks
+    auto on_wl_touch_down(wl_surface* surface, uint32_t id, double x, double y) -> void override;
+    auto on_wl_touch_motion(uint32_t id, double x, double y) -> void override;
+    auto on_wl_touch_up(uint32_t id) -> void override;
+    auto on_wl_touch_frame() -> void override;
+
+    // SurfaceCallbacks
+    auto on_wl_surface_enter(wl_output* output) -> void override;
+    auto on_wl_surface_leave(wl_output* output) -> void override;
+    auto on_wl_surface_preferred_buffer_scale(int32_t factor) -> void override;
+    auto on_wl_surface_preferred_buffer_transform(uint32_t transform) -> void override;
+    auto on_wl_surface_frame() -> void override;
+    auto on_wl_surface_visibility(bool visible) -> void override;
+
+    // OutputCallbacks
+    auto on_wl_output_created(wl_output* output) -> void override;
+    auto on_wl_output_removed(wl_output* output) -> void override;
+    auto on_wl_output_geometry(wl_output* output, int32_t x, int32_t y, int32_t physical_width, int32_t physical_height, int32_t subpixel, const char* make, const char* model, int32_t transform) -> void override;
+    auto on_wl_output_mode(wl_output* output, uint32_t flags, int32_t width, int32_t height, int32_t refresh) -> void override;
+    auto on_wl_output_done(wl_output* output) -> void override;
+    auto on_wl_output_scale(wl_output* output, int32_t scale) -> void override;
+    auto on_wl_output_name(wl_output* output, const char* name) -> void override;
+    auto on_wl_output_description(wl_output* output, const char* description) -> void override;
+
+    // XDGSurfaceCallbacks
+    auto on_xdg_surface_configure() -> void override;
+
+    // XDGToplevelCallbacks
+    auto on_xdg_toplevel_configure(const XDGToplevelState& state) -> void override;
+    auto on_xdg_toplevel_close() -> void override;
+
+    // LayerSurfaceCallbacks
+    auto on_zwlr_layer_surface_configure(uint32_t width, uint32_t height) -> void override;
+    auto on_zwlr_layer_surface_closed() -> void override;
+
+    RecordingCallbacks(Recorder* recorder, uint32_t object);
+};
+
+// logs every event delivered to the wrapped callbacks in a compact binary format
+// pass the returned proxies to towl instead of the application callbacks
+// objects are numbered in the order they are wrapped, starting from 1
+// wl_surface and wl_output arguments are numbered in the order they first appear, 0 being null
+class Recorder {
+  private:
+    friend class RecordingCallbacks;
+
+    int                                              fd = -1;
+    std::chrono::steady_clock::time_point            start;
+    std::vector<std::byte>                           buffer;
+    std::vector<std::unique_ptr<RecordingCallbacks>> proxies;
+    std::vector<void*>                               handles;
+    bool                                             failed = false;
+
+    auto get_handle(void* ptr) -> uint32_t;
+    auto write_record(recording::RecordType type, uint32_t object, std::span<const std::byte> payload) -> void;
+    auto create_proxy() -> RecordingCallbacks&;
+
+  public:
+    auto wrap(PointerCallbacks* callbacks) -> PointerCallbacks*;
+    auto wrap(KeyboardCallbacks* callbacks) -> KeyboardCallbacks*;
+    auto wrap(TouchCallbacks* callbacks) -> TouchCallbacks*;
+    auto wrap(SurfaceCallbacks* callbacks) -> SurfaceCallbacks*;
+    auto wrap(OutputCallbacks* callbacks) -> OutputCallbacks*;
+    auto wrap(XDGSurfaceCallbacks* callbacks) -> XDGSurfaceCallbacks*;
+    auto wrap(XDGToplevelCallbacks* callbacks) -> XDGToplevelCallbacks*;
+    auto wrap(LayerSurfaceCallbacks* callbacks) -> LayerSurfaceCallbacks*;
+    // writes buffered records to the file
+    auto flush() -> bool;
+    // false once a write has failed, recording stops at that point
+    auto is_ok() const -> bool;
+
+    auto open(const char* path) -> bool;
+
+    Recorder() = default;
+    Recorder(Recorder&) = delete;
+    ~Recorder();
+};
+
+// feeds a recorded session back into the same callback interfaces
+// bind the callbacks in the same order they were wrapped during recording
+class Replayer {
+  private:
+    struct Targets {
+        PointerCallbacks*      pointer      = nullptr;
+        KeyboardCallbacks*     keyboard     = nullptr;
+        TouchCallbacks*        touch        = nullptr;
+        SurfaceCallbacks*      surface      = nullptr;
+        OutputCallbacks*       output       = nullptr;
+        XDGSurfaceCallbacks*   xdg_surface  = nullptr;
+        XDGToplevelCallbacks*  xdg_toplevel = nullptr;
+        LayerSurfaceCallbacks* layer        = nullptr;
+    };
+
+    std::vector<std::byte> data;
+    std::vector<Targets>   targets;
+    std::vector<void*>     handles;
+    size_t                 cursor = 0;
+
+    auto get_targets(uint32_t object) -> Targets&;
+    auto get_handle(uint32_t id) const -> void*;
+    auto dispatch(const recording::RecordHeader& header, std::span<const std::byte> payload) -> bool;
+
+  public:
+    auto bind(uint32_t object, PointerCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, KeyboardCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, TouchCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, SurfaceCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, OutputCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, XDGSurfaceCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, XDGToplevelCallbacks* callbacks) -> void;
+    auto bind(uint32_t object, LayerSurfaceCallbacks* callbacks) -> void;
+    // substitutes a live object for the recorded wl_surface or wl_output numbered id
+    // unbound handles are passed as null
+    auto bind_handle(uint32_t id, void* ptr) -> void;
+    // delivers the next record, returns false at the end of the trace or on a malformed record
+    auto step() -> bool;
+    // delivers every remaining record, with the original timing if realtime is set, as fast as possible otherwise
+    auto replay(bool realtime) -> bool;
+    auto rewind() -> void;
+    auto is_finished() const -> bool;
+
+    auto open(const char* path) -> bool;
+};
+} // namespace towl
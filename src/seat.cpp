@@ -18,7 +18,9 @@ auto Seat::capabilities(void* const data, wl_seat* const /*seat*/, const uint32_
     } else {
         self.keyboard.reset();
     }
-    if(self.pointer_callbacks && cap & WL_SEAT_CAPABILITY_POINTER) {
+    if(self.pointer_frame_callbacks && cap & WL_SEAT_CAPABILITY_POINTER) {
+        self.pointer.emplace(wl_seat_get_pointer(self.seat.get()), self.binder->version, self.pointer_frame_callbacks);
+    } else if(self.pointer_callbacks && cap & WL_SEAT_CAPABILITY_POINTER) {
         self.pointer.emplace(wl_seat_get_pointer(self.seat.get()), self.binder->version, self.pointer_callbacks);
     } else {
         self.pointer.reset();
@@ -34,11 +36,16 @@ auto Seat::native() -> wl_seat* {
     return seat.get();
 }
 
-Seat::Seat(void* const data, const uint32_t version, KeyboardCallbacks* const keyboard_callbacks, PointerCallbacks* const pointer_callbacks, TouchCallbacks* const touch_callbacks)
+Seat::Seat(void* const data, const uint32_t version, KeyboardCallbacks* const keyboard_callbacks, PointerCallbacks* const pointer_callbacks, TouchCallbacks* const touch_callbacks, PointerFrameCallbacks* const pointer_frame_callbacks, EventQueue* const queue)
     : seat(std::bit_cast<wl_seat*>(data), {version}),
       keyboard_callbacks(keyboard_callbacks),
       pointer_callbacks(pointer_callbacks),
+      pointer_frame_callbacks(pointer_frame_callbacks),
       touch_callbacks(touch_callbacks) {
+    if(queue != nullptr) {
+        // devices created from the seat inherit its queue
+        queue->assign(seat.get());
+    }
     wl_seat_add_listener(seat.get(), &listener, this);
 }
 
@@ -47,6 +54,6 @@ auto SeatBinder::get_interface_description() -> const wl_interface* {
 }
 
 auto SeatBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
-    return std::unique_ptr<impl::Interface>(new Seat(data, version, keyboard_callbacks, pointer_callbacks, touch_callbacks));
+    return std::unique_ptr<impl::Interface>(new Seat(data, version, keyboard_callbacks, pointer_callbacks, touch_callbacks, pointer_frame_callbacks, queue));
 }
 } // namespace towl
@@ -3,6 +3,7 @@
 
 #include <wayland-client.h>
 
+#include "event-queue.hpp"
 #include "interface.hpp"
 #include "keyboard.hpp"
 #include "pointer.hpp"
@@ -27,6 +28,7 @@ class Seat : public impl::Interface {
     std::optional<Touch>    touch;
     KeyboardCallbacks*      keyboard_callbacks;
     PointerCallbacks*       pointer_callbacks;
+    PointerFrameCallbacks*  pointer_frame_callbacks;
     TouchCallbacks*         touch_callbacks;
 
     static auto capabilities(void* data, wl_seat* seat, uint32_t cap) -> void;
@@ -37,17 +39,31 @@ class Seat : public impl::Interface {
   public:
     auto native() -> wl_seat*;
 
-    Seat(void* data, uint32_t version, KeyboardCallbacks* keyboard_callbacks, PointerCallbacks* pointer_callbacks, TouchCallbacks* touch_callbacks);
+    Seat(void* data, uint32_t version, KeyboardCallbacks* keyboard_callbacks, PointerCallbacks* pointer_callbacks, TouchCallbacks* touch_callbacks, PointerFrameCallbacks* pointer_frame_callbacks = nullptr, EventQueue* queue = nullptr);
 };
 
 // version = 1 ~ 8
 struct SeatBinder : impl::InterfaceBinder {
+    using Interface = Seat;
+
+    static constexpr auto interface_name = std::string_view("wl_seat");
+
     KeyboardCallbacks* keyboard_callbacks; // nullable
     PointerCallbacks*  pointer_callbacks;  // nullable
     TouchCallbacks*    touch_callbacks;    // nullable
 
+    // nullable, takes precedence over pointer_callbacks
+    PointerFrameCallbacks* pointer_frame_callbacks = nullptr;
+
+    // nullable, the seat and its input devices are dispatched on this queue instead of the registry's
+    // assigned at bind time, before any seat event can be queued
+    EventQueue* queue = nullptr;
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data, version, keyboard_callbacks, pointer_callbacks, touch_callbacks, pointer_frame_callbacks, queue);
+    }
 
     SeatBinder(const uint32_t version, KeyboardCallbacks* keyboard_callbacks, PointerCallbacks* pointer_callbacks, TouchCallbacks* touch_callbacks)
         : InterfaceBinder(version),
@@ -43,8 +43,15 @@ class Shell : public impl::Interface {
 
 // version = 1
 struct ShellBinder : impl::InterfaceBinder {
+    using Interface = Shell;
+
+    static constexpr auto interface_name = std::string_view("wl_shell");
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
 
     ShellBinder(const uint32_t version)
         : InterfaceBinder(version) {}
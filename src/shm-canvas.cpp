@@ -0,0 +1,491 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__SSE2__)
+#include <immintrin.h>
+#define TOWL_CANVAS_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TOWL_CANVAS_NEON
+#endif
+
+#include "shm-canvas.hpp"
+#include "transform.hpp"
+
+namespace towl {
+namespace {
+struct Kernels {
+    auto (*fill32)(uint32_t* dst, size_t count, uint32_t value) -> void;
+    auto (*blend)(uint32_t* dst, const uint32_t* src, size_t count) -> void;
+    auto (*swap_rb)(uint32_t* dst, const uint32_t* src, size_t count) -> void;
+    auto (*set_alpha)(uint32_t* dst, const uint32_t* src, size_t count) -> void;
+};
+
+// scalar
+// divides two 16bit channels packed in a word by 255 with rounding
+auto div255x2(const uint32_t value) -> uint32_t {
+    const auto v = value + 0x00800080;
+    return ((v + ((v >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+}
+
+auto blend_pixel(const uint32_t dst, const uint32_t src) -> uint32_t {
+    const auto inv = 255 - (src >> 24);
+    const auto rb  = div255x2((dst & 0x00FF00FF) * inv);
+    const auto ag  = div255x2(((dst >> 8) & 0x00FF00FF) * inv);
+    return src + rb + (ag << 8);
+}
+
+auto fill32_scalar(uint32_t* const dst, const size_t count, const uint32_t value) -> void {
+    std::fill_n(dst, count, value);
+}
+
+auto blend_scalar(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    for(auto i = size_t(0); i < count; i += 1) {
+        dst[i] = blend_pixel(dst[i], src[i]);
+    }
+}
+
+auto swap_rb_scalar(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    for(auto i = size_t(0); i < count; i += 1) {
+        const auto v = src[i];
+        dst[i]       = (v & 0xFF00FF00) | ((v >> 16) & 0xFF) | ((v & 0xFF) << 16);
+    }
+}
+
+auto set_alpha_scalar(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    for(auto i = size_t(0); i < count; i += 1) {
+        dst[i] = src[i] | 0xFF000000;
+    }
+}
+
+#if defined(TOWL_CANVAS_X86)
+// sse2
+auto fill32_sse2(uint32_t* const dst, const size_t count, const uint32_t value) -> void {
+    const auto v = _mm_set1_epi32(value);
+    auto       i = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(std::bit_cast<__m128i*>(dst + i), v);
+    }
+    fill32_scalar(dst + i, count - i, value);
+}
+
+auto div255_sse2(const __m128i value) -> __m128i {
+    const auto v = _mm_add_epi16(value, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+}
+
+auto blend_sse2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto zero = _mm_setzero_si128();
+    const auto full = _mm_set1_epi16(255);
+    auto       i    = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        const auto s = _mm_loadu_si128(std::bit_cast<const __m128i*>(src + i));
+        const auto d = _mm_loadu_si128(std::bit_cast<const __m128i*>(dst + i));
+        // (a r g b) per pixel as 16bit lanes
+        auto lo     = _mm_unpacklo_epi8(s, zero);
+        auto hi     = _mm_unpackhi_epi8(s, zero);
+        auto inv_lo = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF));
+        auto inv_hi = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF));
+        lo          = div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_lo));
+        hi          = div255_sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_hi));
+        const auto r = _mm_add_epi8(s, _mm_packus_epi16(lo, hi));
+        _mm_storeu_si128(std::bit_cast<__m128i*>(dst + i), r);
+    }
+    blend_scalar(dst + i, src + i, count - i);
+}
+
+auto swap_rb_sse2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto ag_mask = _mm_set1_epi32(0xFF00FF00);
+    const auto b_mask  = _mm_set1_epi32(0x000000FF);
+    auto       i       = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        const auto v  = _mm_loadu_si128(std::bit_cast<const __m128i*>(src + i));
+        const auto ag = _mm_and_si128(v, ag_mask);
+        const auto r  = _mm_and_si128(_mm_srli_epi32(v, 16), b_mask);
+        const auto b  = _mm_slli_epi32(_mm_and_si128(v, b_mask), 16);
+        _mm_storeu_si128(std::bit_cast<__m128i*>(dst + i), _mm_or_si128(ag, _mm_or_si128(r, b)));
+    }
+    swap_rb_scalar(dst + i, src + i, count - i);
+}
+
+auto set_alpha_sse2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto alpha = _mm_set1_epi32(0xFF000000);
+    auto       i     = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        const auto v = _mm_loadu_si128(std::bit_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(std::bit_cast<__m128i*>(dst + i), _mm_or_si128(v, alpha));
+    }
+    set_alpha_scalar(dst + i, src + i, count - i);
+}
+
+// avx2
+[[gnu::target("avx2")]] auto fill32_avx2(uint32_t* const dst, const size_t count, const uint32_t value) -> void {
+    const auto v = _mm256_set1_epi32(value);
+    auto       i = size_t(0);
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(std::bit_cast<__m256i*>(dst + i), v);
+    }
+    fill32_scalar(dst + i, count - i, value);
+}
+
+[[gnu::target("avx2")]] auto div255_avx2(const __m256i value) -> __m256i {
+    const auto v = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), 8);
+}
+
+[[gnu::target("avx2")]] auto blend_avx2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto zero = _mm256_setzero_si256();
+    const auto full = _mm256_set1_epi16(255);
+    auto       i    = size_t(0);
+    for(; i + 8 <= count; i += 8) {
+        const auto s = _mm256_loadu_si256(std::bit_cast<const __m256i*>(src + i));
+        const auto d = _mm256_loadu_si256(std::bit_cast<const __m256i*>(dst + i));
+        // unpack and pack both work within 128bit lanes, so the pixel order is preserved
+        auto lo     = _mm256_unpacklo_epi8(s, zero);
+        auto hi     = _mm256_unpackhi_epi8(s, zero);
+        auto inv_lo = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF));
+        auto inv_hi = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF));
+        lo          = div255_avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv_lo));
+        hi          = div255_avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv_hi));
+        const auto r = _mm256_add_epi8(s, _mm256_packus_epi16(lo, hi));
+        _mm256_storeu_si256(std::bit_cast<__m256i*>(dst + i), r);
+    }
+    blend_sse2(dst + i, src + i, count - i);
+}
+
+[[gnu::target("avx2")]] auto swap_rb_avx2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                          2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    auto       i       = size_t(0);
+    for(; i + 8 <= count; i += 8) {
+        const auto v = _mm256_loadu_si256(std::bit_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(std::bit_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, shuffle));
+    }
+    swap_rb_sse2(dst + i, src + i, count - i);
+}
+
+[[gnu::target("avx2")]] auto set_alpha_avx2(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto alpha = _mm256_set1_epi32(0xFF000000);
+    auto       i     = size_t(0);
+    for(; i + 8 <= count; i += 8) {
+        const auto v = _mm256_loadu_si256(std::bit_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(std::bit_cast<__m256i*>(dst + i), _mm256_or_si256(v, alpha));
+    }
+    set_alpha_sse2(dst + i, src + i, count - i);
+}
+#elif defined(TOWL_CANVAS_NEON)
+auto fill32_neon(uint32_t* const dst, const size_t count, const uint32_t value) -> void {
+    const auto v = vdupq_n_u32(value);
+    auto       i = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, v);
+    }
+    fill32_scalar(dst + i, count - i, value);
+}
+
+auto blend_neon(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    auto i = size_t(0);
+    for(; i + 8 <= count; i += 8) {
+        const auto s   = vld4_u8(std::bit_cast<const uint8_t*>(src + i));
+        auto       d   = vld4_u8(std::bit_cast<const uint8_t*>(dst + i));
+        const auto inv = vmvn_u8(s.val[3]);
+        for(auto c = 0; c < 4; c += 1) {
+            const auto m = vmull_u8(d.val[c], inv);
+            d.val[c]     = vqadd_u8(s.val[c], vraddhn_u16(m, vrshrq_n_u16(m, 8)));
+        }
+        vst4_u8(std::bit_cast<uint8_t*>(dst + i), d);
+    }
+    blend_scalar(dst + i, src + i, count - i);
+}
+
+auto swap_rb_neon(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    auto i = size_t(0);
+    for(; i + 16 <= count; i += 16) {
+        auto v = vld4q_u8(std::bit_cast<const uint8_t*>(src + i));
+        std::swap(v.val[0], v.val[2]);
+        vst4q_u8(std::bit_cast<uint8_t*>(dst + i), v);
+    }
+    swap_rb_scalar(dst + i, src + i, count - i);
+}
+
+auto set_alpha_neon(uint32_t* const dst, const uint32_t* const src, const size_t count) -> void {
+    const auto alpha = vdupq_n_u32(0xFF000000);
+    auto       i     = size_t(0);
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, vorrq_u32(vld1q_u32(src + i), alpha));
+    }
+    set_alpha_scalar(dst + i, src + i, count - i);
+}
+#endif
+
+auto select_kernels() -> Kernels {
+#if defined(TOWL_CANVAS_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        return {fill32_avx2, blend_avx2, swap_rb_avx2, set_alpha_avx2};
+    }
+    return {fill32_sse2, blend_sse2, swap_rb_sse2, set_alpha_sse2};
+#elif defined(TOWL_CANVAS_NEON)
+    return {fill32_neon, blend_neon, swap_rb_neon, set_alpha_neon};
+#else
+    return {fill32_scalar, blend_scalar, swap_rb_scalar, set_alpha_scalar};
+#endif
+}
+
+const auto kernels = select_kernels();
+
+// format conversion through ARGB8888 rows
+auto expand(const uint32_t value, const uint32_t bits) -> uint32_t {
+    const auto v = value << (8 - bits);
+    return v | (v >> bits);
+}
+
+auto to_argb(uint32_t* const dst, const uint8_t* const src, const size_t count, const uint32_t format) -> void {
+    const auto src32 = std::bit_cast<const uint32_t*>(src);
+    switch(format) {
+    case WL_SHM_FORMAT_ARGB8888:
+        std::memcpy(dst, src, count * 4);
+        break;
+    case WL_SHM_FORMAT_XRGB8888:
+        kernels.set_alpha(dst, src32, count);
+        break;
+    case WL_SHM_FORMAT_ABGR8888:
+        kernels.swap_rb(dst, src32, count);
+        break;
+    case WL_SHM_FORMAT_XBGR8888:
+        kernels.swap_rb(dst, src32, count);
+        kernels.set_alpha(dst, dst, count);
+        break;
+    case WL_SHM_FORMAT_RGB565: {
+        const auto src16 = std::bit_cast<const uint16_t*>(src);
+        for(auto i = size_t(0); i < count; i += 1) {
+            const auto v = uint32_t(src16[i]);
+            dst[i]       = 0xFF000000 | expand(v >> 11, 5) << 16 | expand((v >> 5) & 0x3F, 6) << 8 | expand(v & 0x1F, 5);
+        }
+    } break;
+    case WL_SHM_FORMAT_ARGB2101010:
+    case WL_SHM_FORMAT_XRGB2101010: {
+        const auto opaque = format == WL_SHM_FORMAT_XRGB2101010;
+        for(auto i = size_t(0); i < count; i += 1) {
+            const auto v = src32[i];
+            const auto a = opaque ? 0xFF : (v >> 30) * 0x55;
+            dst[i]       = a << 24 | ((v >> 22) & 0xFF) << 16 | ((v >> 12) & 0xFF) << 8 | ((v >> 2) & 0xFF);
+        }
+    } break;
+    }
+}
+
+auto from_argb(uint8_t* const dst, const uint32_t* const src, const size_t count, const uint32_t format) -> void {
+    const auto dst32 = std::bit_cast<uint32_t*>(dst);
+    switch(format) {
+    case WL_SHM_FORMAT_ARGB8888:
+    case WL_SHM_FORMAT_XRGB8888:
+        std::memcpy(dst, src, count * 4);
+        break;
+    case WL_SHM_FORMAT_ABGR8888:
+    case WL_SHM_FORMAT_XBGR8888:
+        kernels.swap_rb(dst32, src, count);
+        break;
+    case WL_SHM_FORMAT_RGB565: {
+        const auto dst16 = std::bit_cast<uint16_t*>(dst);
+        for(auto i = size_t(0); i < count; i += 1) {
+            const auto v = src[i];
+            dst16[i]     = uint16_t((v >> 8 & 0xF800) | (v >> 5 & 0x07E0) | (v >> 3 & 0x001F));
+        }
+    } break;
+    case WL_SHM_FORMAT_ARGB2101010:
+    case WL_SHM_FORMAT_XRGB2101010:
+        for(auto i = size_t(0); i < count; i += 1) {
+            const auto v = src[i];
+            const auto r = ((v >> 16) & 0xFF) << 2 | (v >> 22 & 0x3);
+            const auto g = ((v >> 8) & 0xFF) << 2 | (v >> 14 & 0x3);
+            const auto b = (v & 0xFF) << 2 | (v >> 6 & 0x3);
+            dst32[i]     = (v >> 30) << 30 | r << 20 | g << 10 | b;
+        }
+        break;
+    }
+}
+
+auto is_argb_order(const uint32_t format) -> bool {
+    return format == WL_SHM_FORMAT_ARGB8888 || format == WL_SHM_FORMAT_XRGB8888;
+}
+
+auto is_abgr_order(const uint32_t format) -> bool {
+    return format == WL_SHM_FORMAT_ABGR8888 || format == WL_SHM_FORMAT_XBGR8888;
+}
+
+auto has_alpha(const uint32_t format) -> bool {
+    return format == WL_SHM_FORMAT_ARGB8888 || format == WL_SHM_FORMAT_ABGR8888 || format == WL_SHM_FORMAT_ARGB2101010;
+}
+
+// clips the source rectangle by both canvases, moving the destination position along
+auto clip_copy(const Rect& dst_bounds, const Rect& src_bounds, Rect& src_rect, int32_t& x, int32_t& y) -> bool {
+    auto clipped = src_rect.intersect(src_bounds);
+    x += clipped.x - src_rect.x;
+    y += clipped.y - src_rect.y;
+    const auto dst = Rect{x, y, clipped.width, clipped.height}.intersect(dst_bounds);
+    src_rect       = {clipped.x + dst.x - x, clipped.y + dst.y - y, dst.width, dst.height};
+    x              = dst.x;
+    y              = dst.y;
+    return !src_rect.empty();
+}
+} // namespace
+
+auto is_canvas_format_supported(const uint32_t format) -> bool {
+    switch(format) {
+    case WL_SHM_FORMAT_ARGB8888:
+    case WL_SHM_FORMAT_XRGB8888:
+    case WL_SHM_FORMAT_ABGR8888:
+    case WL_SHM_FORMAT_XBGR8888:
+    case WL_SHM_FORMAT_RGB565:
+    case WL_SHM_FORMAT_ARGB2101010:
+    case WL_SHM_FORMAT_XRGB2101010:
+        return true;
+    default:
+        return false;
+    }
+}
+
+auto ShmCanvas::get_row(const int32_t y) const -> uint8_t* {
+    return data + size_t(y) * stride;
+}
+
+auto ShmCanvas::get_bounds() const -> Rect {
+    return {0, 0, width, height};
+}
+
+auto ShmCanvas::get_format() const -> uint32_t {
+    return format;
+}
+
+auto ShmCanvas::clear(const uint32_t argb) -> void {
+    fill(get_bounds(), argb);
+}
+
+auto ShmCanvas::fill(Rect rect, const uint32_t argb) -> void {
+    rect = rect.intersect(get_bounds());
+    if(rect.empty()) {
+        return;
+    }
+    auto pixel = uint32_t(0);
+    from_argb(std::bit_cast<uint8_t*>(&pixel), &argb, 1, format);
+    if(format == WL_SHM_FORMAT_RGB565) {
+        for(auto y = rect.y; y < rect.y + rect.height; y += 1) {
+            std::fill_n(std::bit_cast<uint16_t*>(get_row(y)) + rect.x, rect.width, uint16_t(pixel));
+        }
+        return;
+    }
+    for(auto y = rect.y; y < rect.y + rect.height; y += 1) {
+        kernels.fill32(std::bit_cast<uint32_t*>(get_row(y)) + rect.x, rect.width, pixel);
+    }
+}
+
+auto ShmCanvas::blit(const ShmCanvas& src, Rect src_rect, int32_t x, int32_t y) -> void {
+    if(!clip_copy(get_bounds(), src.get_bounds(), src_rect, x, y)) {
+        return;
+    }
+    const auto src_bpp = src.format == WL_SHM_FORMAT_RGB565 ? 2 : 4;
+    const auto dst_bpp = format == WL_SHM_FORMAT_RGB565 ? 2 : 4;
+    // rows are walked backwards when copying downwards within the same buffer
+    const auto reverse = src.data == data && y > src_rect.y;
+    auto       row     = std::vector<uint32_t>();
+    for(auto i = 0; i < src_rect.height; i += 1) {
+        const auto r = reverse ? src_rect.height - 1 - i : i;
+        const auto s = src.get_row(src_rect.y + r) + src_rect.x * src_bpp;
+        const auto d = get_row(y + r) + x * dst_bpp;
+        if(src.format == format) {
+            std::memmove(d, s, size_t(src_rect.width) * dst_bpp);
+        } else if(is_argb_order(src.format) && is_argb_order(format)) {
+            kernels.set_alpha(std::bit_cast<uint32_t*>(d), std::bit_cast<const uint32_t*>(s), src_rect.width);
+        } else if(src.format == WL_SHM_FORMAT_ARGB8888 && format == WL_SHM_FORMAT_ABGR8888) {
+            kernels.swap_rb(std::bit_cast<uint32_t*>(d), std::bit_cast<const uint32_t*>(s), src_rect.width);
+        } else {
+            row.resize(src_rect.width);
+            to_argb(row.data(), s, src_rect.width, src.format);
+            from_argb(d, row.data(), src_rect.width, format);
+        }
+    }
+}
+
+auto ShmCanvas::blend(const ShmCanvas& src, Rect src_rect, int32_t x, int32_t y) -> void {
+    // the padding byte of x formats is undefined, such sources are opaque
+    if(!has_alpha(src.format)) {
+        blit(src, src_rect, x, y);
+        return;
+    }
+    if(!clip_copy(get_bounds(), src.get_bounds(), src_rect, x, y)) {
+        return;
+    }
+    const auto src_bpp = src.format == WL_SHM_FORMAT_RGB565 ? 2 : 4;
+    const auto dst_bpp = format == WL_SHM_FORMAT_RGB565 ? 2 : 4;
+    const auto direct  = (is_argb_order(src.format) && is_argb_order(format)) || (is_abgr_order(src.format) && is_abgr_order(format));
+    auto       src_row = std::vector<uint32_t>();
+    auto       dst_row = std::vector<uint32_t>();
+    for(auto i = 0; i < src_rect.height; i += 1) {
+        const auto s = src.get_row(src_rect.y + i) + src_rect.x * src_bpp;
+        const auto d = get_row(y + i) + x * dst_bpp;
+        if(direct) {
+            kernels.blend(std::bit_cast<uint32_t*>(d), std::bit_cast<const uint32_t*>(s), src_rect.width);
+            continue;
+        }
+        src_row.resize(src_rect.width);
+        dst_row.resize(src_rect.width);
+        to_argb(src_row.data(), s, src_rect.width, src.format);
+        to_argb(dst_row.data(), d, src_rect.width, format);
+        kernels.blend(dst_row.data(), src_row.data(), src_rect.width);
+        from_argb(d, dst_row.data(), src_rect.width, format);
+    }
+}
+
+auto ShmCanvas::blit_transformed(const ShmCanvas& src, const uint32_t transform) -> bool {
+    if(get_transformed_size(transform, src.width, src.height) != std::pair{width, height}) {
+        return false;
+    }
+    const auto dst_bpp = format == WL_SHM_FORMAT_RGB565 ? 2 : 4;
+
+    // destination pixel of source (x, y) is origin + x * step_x + y * step_y, in bytes
+    const auto offset = [&](const int32_t x, const int32_t y) -> ptrdiff_t {
+        // pixel centers, so that the result lands on integer pixels
+        const auto [bx, by] = surface_to_buffer(transform, src.width, src.height, x + 0.5, y + 0.5);
+        return ptrdiff_t(by - 0.5) * stride + ptrdiff_t(bx - 0.5) * dst_bpp;
+    };
+    const auto origin = offset(0, 0);
+    const auto step_x = offset(1, 0) - origin;
+    const auto step_y = offset(0, 1) - origin;
+
+    auto argb = std::vector<uint32_t>(src.width);
+    auto row  = std::vector<uint8_t>(size_t(src.width) * dst_bpp);
+    for(auto y = 0; y < src.height; y += 1) {
+        const auto s = src.get_row(y);
+        if(src.format == format) {
+            std::memcpy(row.data(), s, row.size());
+        } else {
+            to_argb(argb.data(), s, src.width, src.format);
+            from_argb(row.data(), argb.data(), src.width, format);
+        }
+        auto d = data + origin + y * step_y;
+        if(dst_bpp == 4) {
+            const auto r = std::bit_cast<const uint32_t*>(row.data());
+            for(auto x = 0; x < src.width; x += 1, d += step_x) {
+                *std::bit_cast<uint32_t*>(d) = r[x];
+            }
+        } else {
+            const auto r = std::bit_cast<const uint16_t*>(row.data());
+            for(auto x = 0; x < src.width; x += 1, d += step_x) {
+                *std::bit_cast<uint16_t*>(d) = r[x];
+            }
+        }
+    }
+    return true;
+}
+
+ShmCanvas::ShmCanvas(uint8_t* const data, const int32_t width, const int32_t height, const int32_t stride, const uint32_t format)
+    : data(data),
+      width(width),
+      height(height),
+      stride(stride),
+      format(format) {}
+} // namespace towl
@@ -0,0 +1,37 @@
+#pragma once
+#include <wayland-client.h>
+
+#include "damage.hpp"
+
+namespace towl {
+auto is_canvas_format_supported(uint32_t format) -> bool;
+
+// pixel operations over a mapped shm buffer
+// colors are given as ARGB8888 and converted to the canvas format
+// supported formats are ARGB8888, XRGB8888, ABGR8888, XBGR8888, RGB565, ARGB2101010 and XRGB2101010
+class ShmCanvas {
+  private:
+    uint8_t* data;
+    int32_t  width;
+    int32_t  height;
+    int32_t  stride;
+    uint32_t format;
+
+    auto get_row(int32_t y) const -> uint8_t*;
+
+  public:
+    auto get_bounds() const -> Rect;
+    auto get_format() const -> uint32_t;
+    auto clear(uint32_t argb) -> void;
+    auto fill(Rect rect, uint32_t argb) -> void;
+    // copies src_rect of src to (x, y), converting between formats if they differ
+    auto blit(const ShmCanvas& src, Rect src_rect, int32_t x, int32_t y) -> void;
+    // composites premultiplied src over this canvas
+    auto blend(const ShmCanvas& src, Rect src_rect, int32_t x, int32_t y) -> void;
+    // copies the whole src with a wl_output_transform applied, so that it can be committed with set_buffer_transform(transform)
+    // returns false unless this canvas is exactly get_transformed_size() of src
+    auto blit_transformed(const ShmCanvas& src, uint32_t transform) -> bool;
+
+    ShmCanvas(uint8_t* data, int32_t width, int32_t height, int32_t stride, uint32_t format);
+};
+} // namespace towl
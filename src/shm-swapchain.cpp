@@ -0,0 +1,148 @@
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "macros/assert.hpp"
+#include "shm-swapchain.hpp"
+
+namespace towl {
+auto ShmSwapchainBuffer::on_wl_buffer_release() -> void {
+    parent->on_release(*this);
+}
+
+auto ShmSwapchainBuffer::native() -> wl_buffer* {
+    return buffer.native();
+}
+
+auto ShmSwapchain::map(const size_t size) -> bool {
+    ensure(ftruncate(fd, size) == 0);
+    if(mapping != nullptr) {
+        munmap(mapping, pool_size);
+    }
+    const auto ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ensure(ptr != MAP_FAILED);
+    mapping   = static_cast<uint8_t*>(ptr);
+    pool_size = size;
+    // the file only grows, so busy buffers stay valid at the offset of their wl_buffer until recreate_buffer moves them
+    for(auto& buffer : buffers) {
+        buffer.data = mapping + buffer.offset;
+    }
+    return true;
+}
+
+auto ShmSwapchain::recreate_buffer(ShmSwapchainBuffer& buffer) -> void {
+    buffer.offset = buffer.index * capacity;
+    buffer.buffer = pool.create_buffer(buffer.offset, width, height, stride, format);
+    buffer.buffer.init(&buffer);
+    buffer.data       = mapping + buffer.offset;
+    buffer.width      = width;
+    buffer.height     = height;
+    buffer.stride     = stride;
+    buffer.last_frame = 0;
+}
+
+auto ShmSwapchain::on_release(ShmSwapchainBuffer& buffer) -> void {
+    buffer.busy = false;
+    if(buffer.stale) {
+        recreate_buffer(buffer);
+        buffer.stale = false;
+        stale_count -= 1;
+        if(stale_count == 0) {
+            relocated = false;
+        }
+    }
+    free_buffers.push_back(buffer.index);
+}
+
+auto ShmSwapchain::init(Shm& shm, const uint32_t count, const int32_t width, const int32_t height, const uint32_t format) -> bool {
+    ensure(fd == -1 && count > 0);
+    fd = memfd_create("towl-swapchain", MFD_CLOEXEC);
+    ensure(fd >= 0);
+
+    this->width  = width;
+    this->height = height;
+    this->stride = width * get_shm_format_bpp(format);
+    this->format = format;
+    capacity     = size_t(stride) * height;
+
+    buffers.resize(count);
+    free_buffers.reserve(count);
+    for(auto i = uint32_t(0); i < count; i += 1) {
+        buffers[i].parent = this;
+        buffers[i].index  = i;
+    }
+    ensure(map(capacity * count));
+    pool = shm.create_shm_pool(fd, pool_size);
+    for(auto i = uint32_t(0); i < count; i += 1) {
+        recreate_buffer(buffers[i]);
+        free_buffers.push_back(count - 1 - i);
+    }
+    return true;
+}
+
+auto ShmSwapchain::resize(const int32_t width, const int32_t height) -> bool {
+    const auto stride = int32_t(width * get_shm_format_bpp(format));
+    if(width == this->width && height == this->height) {
+        return true;
+    }
+    this->width  = width;
+    this->height = height;
+    this->stride = stride;
+
+    if(const auto required = size_t(stride) * height; required > capacity) {
+        // wl_shm_pool can only grow, so keep the old capacity when shrinking
+        capacity = required;
+        ensure(map(capacity * buffers.size()));
+        pool.resize(pool_size);
+        relocated = true;
+    }
+    for(auto& buffer : buffers) {
+        if(buffer.busy) {
+            if(!buffer.stale) {
+                buffer.stale = true;
+                stale_count += 1;
+            }
+        } else {
+            recreate_buffer(buffer);
+        }
+    }
+    if(stale_count == 0) {
+        relocated = false;
+    }
+    return true;
+}
+
+auto ShmSwapchain::acquire() -> ShmSwapchainBuffer* {
+    // after relocation, free buffers may overlap with memory still read by the compositor
+    if(free_buffers.empty() || relocated) {
+        return nullptr;
+    }
+    auto& buffer = buffers[free_buffers.back()];
+    free_buffers.pop_back();
+    frame += 1;
+    buffer.busy       = true;
+    buffer.age        = buffer.last_frame == 0 ? 0 : frame - buffer.last_frame;
+    buffer.last_frame = frame;
+    return &buffer;
+}
+
+auto ShmSwapchain::discard(ShmSwapchainBuffer& buffer) -> void {
+    ASSERT(buffer.parent == this && buffer.busy);
+    // contents are whatever the caller left, not a presented frame
+    buffer.last_frame = 0;
+    on_release(buffer);
+}
+
+auto ShmSwapchain::get_free_count() const -> size_t {
+    return relocated ? 0 : free_buffers.size();
+}
+
+ShmSwapchain::~ShmSwapchain() {
+    buffers.clear();
+    if(mapping != nullptr) {
+        munmap(mapping, pool_size);
+    }
+    if(fd >= 0) {
+        close(fd);
+    }
+}
+} // namespace towl
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+
+#include "shm.hpp"
+
+namespace towl {
+class ShmSwapchain;
+
+class ShmSwapchainBuffer : public BufferCallbacks {
+  private:
+    friend class ShmSwapchain;
+
+    ShmSwapchain* parent;
+    Buffer        buffer;
+    uint32_t      index;
+    size_t        offset     = 0; // in the pool, of the wl_buffer currently backing this buffer
+    uint64_t      last_frame = 0;
+    bool          busy       = false;
+    bool          stale      = false;
+
+    auto on_wl_buffer_release() -> void override;
+
+  public:
+    uint8_t* data;
+    int32_t  width;
+    int32_t  height;
+    int32_t  stride;
+    uint32_t age; // frames since this buffer was last acquired, 0 if the contents are undefined
+
+    auto native() -> wl_buffer*;
+};
+
+// carves a fixed number of buffers out of a single memfd-backed pool
+// buffers returned by acquire() are owned by the compositor until it sends wl_buffer.release
+class ShmSwapchain {
+  private:
+    friend class ShmSwapchainBuffer;
+
+    int                             fd      = -1;
+    uint8_t*                        mapping = nullptr;
+    size_t                          pool_size;
+    size_t                          capacity; // bytes reserved for each buffer
+    int32_t                         width;
+    int32_t                         height;
+    int32_t                         stride;
+    uint32_t                        format;
+    uint64_t                        frame       = 0;
+    uint32_t                        stale_count = 0;
+    bool                            relocated   = false;
+    ShmPool                         pool;
+    std::vector<ShmSwapchainBuffer> buffers;
+    std::vector<uint32_t>           free_buffers;
+
+    auto map(size_t size) -> bool;
+    auto recreate_buffer(ShmSwapchainBuffer& buffer) -> void;
+    auto on_release(ShmSwapchainBuffer& buffer) -> void;
+
+  public:
+    auto init(Shm& shm, uint32_t count, int32_t width, int32_t height, uint32_t format) -> bool;
+    auto resize(int32_t width, int32_t height) -> bool;
+    auto acquire() -> ShmSwapchainBuffer*; // nullable
+    // gives back a buffer that was acquired but never attached
+    auto discard(ShmSwapchainBuffer& buffer) -> void;
+    auto get_free_count() const -> size_t;
+
+    ShmSwapchain() = default;
+    ShmSwapchain(ShmSwapchain&) = delete;
+    ~ShmSwapchain();
+};
+} // namespace towl
@@ -1,11 +1,83 @@
+#include <algorithm>
+#include <array>
+
 #include "shm.hpp"
 #include "macros/assert.hpp"
 
 namespace towl {
+auto get_shm_format_bpp(const uint32_t format) -> uint32_t {
+    switch(format) {
+    case WL_SHM_FORMAT_C8:
+    case WL_SHM_FORMAT_R8:
+    case WL_SHM_FORMAT_RGB332:
+    case WL_SHM_FORMAT_BGR233:
+        return 1;
+    case WL_SHM_FORMAT_RGB565:
+    case WL_SHM_FORMAT_BGR565:
+    case WL_SHM_FORMAT_XRGB4444:
+    case WL_SHM_FORMAT_ARGB4444:
+    case WL_SHM_FORMAT_XRGB1555:
+    case WL_SHM_FORMAT_ARGB1555:
+    case WL_SHM_FORMAT_RG88:
+        return 2;
+    case WL_SHM_FORMAT_RGB888:
+    case WL_SHM_FORMAT_BGR888:
+        return 3;
+    case WL_SHM_FORMAT_XRGB16161616:
+    case WL_SHM_FORMAT_ARGB16161616:
+    case WL_SHM_FORMAT_XBGR16161616:
+    case WL_SHM_FORMAT_ABGR16161616:
+    case WL_SHM_FORMAT_XBGR16161616F:
+    case WL_SHM_FORMAT_ABGR16161616F:
+        return 8;
+    default:
+        return 4;
+    }
+}
+
+auto shm_format_has_alpha(const uint32_t format) -> bool {
+    switch(format) {
+    case WL_SHM_FORMAT_ARGB8888:
+    case WL_SHM_FORMAT_ABGR8888:
+    case WL_SHM_FORMAT_RGBA8888:
+    case WL_SHM_FORMAT_BGRA8888:
+    case WL_SHM_FORMAT_ARGB4444:
+    case WL_SHM_FORMAT_ABGR4444:
+    case WL_SHM_FORMAT_RGBA4444:
+    case WL_SHM_FORMAT_BGRA4444:
+    case WL_SHM_FORMAT_ARGB1555:
+    case WL_SHM_FORMAT_ABGR1555:
+    case WL_SHM_FORMAT_RGBA5551:
+    case WL_SHM_FORMAT_BGRA5551:
+    case WL_SHM_FORMAT_ARGB2101010:
+    case WL_SHM_FORMAT_ABGR2101010:
+    case WL_SHM_FORMAT_RGBA1010102:
+    case WL_SHM_FORMAT_BGRA1010102:
+    case WL_SHM_FORMAT_ARGB16161616:
+    case WL_SHM_FORMAT_ABGR16161616:
+    case WL_SHM_FORMAT_ABGR16161616F:
+        return true;
+    default:
+        return false;
+    }
+}
+
+auto Buffer::release(void* const data, wl_buffer* const /*buffer*/) -> void {
+    auto& self = *std::bit_cast<Buffer*>(data);
+    self.callbacks->on_wl_buffer_release();
+}
+
 auto Buffer::native() -> wl_buffer* {
     return buffer.get();
 }
 
+auto Buffer::init(BufferCallbacks* const callbacks) -> bool {
+    ensure(buffer);
+    this->callbacks = callbacks;
+    wl_buffer_add_listener(buffer.get(), &listener, this);
+    return true;
+}
+
 Buffer::Buffer(wl_buffer* const buffer) : buffer(buffer) {
     ASSERT(buffer != NULL);
 }
@@ -14,16 +86,64 @@ auto ShmPool::create_buffer(const int32_t offset, const int32_t width, const int
     return wl_shm_pool_create_buffer(shm_pool.get(), offset, width, height, stride, format);
 }
 
+auto ShmPool::resize(const int32_t size) -> void {
+    wl_shm_pool_resize(shm_pool.get(), size);
+}
+
 ShmPool::ShmPool(wl_shm_pool* const shm_pool) : shm_pool(shm_pool) {
     ASSERT(shm_pool != NULL);
 }
 
+auto Shm::format(void* const data, wl_shm* const /*shm*/, const uint32_t format) -> void {
+    auto&      self = *std::bit_cast<Shm*>(data);
+    const auto pos  = std::lower_bound(self.formats.begin(), self.formats.end(), format);
+    if(pos == self.formats.end() || *pos != format) {
+        self.formats.insert(pos, format);
+    }
+}
+
 auto Shm::create_shm_pool(const int posix_shm, const size_t size) -> ShmPool {
     return wl_shm_create_pool(shm.get(), posix_shm, size);
 }
 
+auto Shm::get_formats() const -> std::span<const uint32_t> {
+    return formats;
+}
+
+auto Shm::has_format(const uint32_t format) const -> bool {
+    return std::binary_search(formats.begin(), formats.end(), format);
+}
+
+auto Shm::choose_format(const ShmFormatUsage usage) const -> uint32_t {
+    constexpr auto alpha         = std::array<uint32_t, 2>{WL_SHM_FORMAT_ARGB8888, WL_SHM_FORMAT_ABGR8888};
+    constexpr auto opaque        = std::array<uint32_t, 2>{WL_SHM_FORMAT_XRGB8888, WL_SHM_FORMAT_XBGR8888};
+    constexpr auto low_bandwidth = std::array<uint32_t, 3>{WL_SHM_FORMAT_RGB565, WL_SHM_FORMAT_XRGB8888, WL_SHM_FORMAT_XBGR8888};
+
+    auto candidates = std::span<const uint32_t>();
+    switch(usage) {
+    case ShmFormatUsage::Alpha:
+        candidates = alpha;
+        break;
+    case ShmFormatUsage::Opaque:
+        candidates = opaque;
+        break;
+    case ShmFormatUsage::LowBandwidth:
+        candidates = low_bandwidth;
+        break;
+    }
+    for(const auto format : candidates) {
+        if(has_format(format)) {
+            return format;
+        }
+    }
+    // both are supported by every compositor
+    return usage == ShmFormatUsage::Alpha ? WL_SHM_FORMAT_ARGB8888 : WL_SHM_FORMAT_XRGB8888;
+}
+
 Shm::Shm(void* const data)
-    : shm(std::bit_cast<wl_shm*>(data)) {}
+    : shm(std::bit_cast<wl_shm*>(data)) {
+    wl_shm_add_listener(shm.get(), &listener, this);
+}
 
 auto ShmBinder::get_interface_description() -> const wl_interface* {
     return &wl_shm_interface;
@@ -1,4 +1,7 @@
 #pragma once
+#include <span>
+#include <vector>
+
 #include <wayland-client.h>
 
 #include "interface.hpp"
@@ -11,13 +14,29 @@ declare_autoptr(NativeShm, wl_shm, wl_shm_destroy);
 } // namespace towl::impl
 
 namespace towl {
+auto get_shm_format_bpp(uint32_t format) -> uint32_t;
+auto shm_format_has_alpha(uint32_t format) -> bool;
+
+class BufferCallbacks {
+  public:
+    virtual auto on_wl_buffer_release() -> void {}
+    virtual ~BufferCallbacks() {}
+};
+
 class Buffer {
   private:
     impl::AutoNativeBuffer buffer;
+    BufferCallbacks*       callbacks;
+
+    static auto release(void* data, wl_buffer* buffer) -> void;
+
+    static inline wl_buffer_listener listener = {release};
 
   public:
     auto native() -> wl_buffer*;
+    auto init(BufferCallbacks* callbacks) -> bool;
 
+    Buffer() = default;
     Buffer(wl_buffer* buffer);
 };
 
@@ -27,24 +46,48 @@ class ShmPool {
 
   public:
     auto create_buffer(int32_t offset, int32_t width, int32_t height, int32_t stride, uint32_t format) -> Buffer;
+    auto resize(int32_t size) -> void;
 
+    ShmPool() = default;
     ShmPool(wl_shm_pool* const shm_pool);
 };
 
+enum class ShmFormatUsage {
+    Alpha,        // needs an alpha channel
+    Opaque,       // prefers formats without alpha so that the compositor can skip blending
+    LowBandwidth, // prefers 16bit formats
+};
+
 class Shm : public impl::Interface {
   private:
-    impl::AutoNativeShm shm;
+    impl::AutoNativeShm   shm;
+    std::vector<uint32_t> formats; // sorted
+
+    static auto format(void* data, wl_shm* shm, uint32_t format) -> void;
+
+    static inline wl_shm_listener listener = {format};
 
   public:
     auto create_shm_pool(int posix_shm, size_t size) -> ShmPool;
+    auto get_formats() const -> std::span<const uint32_t>;
+    auto has_format(uint32_t format) const -> bool;
+    // falls back to ARGB8888 or XRGB8888, which every compositor supports, if nothing better is advertised
+    auto choose_format(ShmFormatUsage usage) const -> uint32_t;
 
     Shm(void* data);
 };
 
 // version = 1
 struct ShmBinder : impl::InterfaceBinder {
+    using Interface = Shm;
+
+    static constexpr auto interface_name = std::string_view("wl_shm");
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
 
     ShmBinder(const uint32_t version)
         : InterfaceBinder(version) {}
@@ -0,0 +1,100 @@
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "macros/assert.hpp"
+#include "single-pixel-buffer.hpp"
+
+namespace towl {
+namespace {
+auto expand_channel(const uint32_t argb, const uint32_t shift) -> uint32_t {
+    return ((argb >> shift) & 0xFF) * 0x01010101u;
+}
+} // namespace
+
+auto SinglePixelBufferManager::create_buffer(const uint32_t argb) -> Buffer {
+    return {wp_single_pixel_buffer_manager_v1_create_u32_rgba_buffer(manager.get(),
+                                                                    expand_channel(argb, 16),
+                                                                    expand_channel(argb, 8),
+                                                                    expand_channel(argb, 0),
+                                                                    expand_channel(argb, 24))};
+}
+
+SinglePixelBufferManager::SinglePixelBufferManager(void* const data)
+    : manager(std::bit_cast<wp_single_pixel_buffer_manager_v1*>(data)) {}
+
+auto SinglePixelBufferManagerBinder::get_interface_description() -> const wl_interface* {
+    return &wp_single_pixel_buffer_manager_v1_interface;
+}
+
+auto SinglePixelBufferManagerBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
+    return std::unique_ptr<impl::Interface>(new SinglePixelBufferManager(data));
+}
+
+auto SolidBufferCache::create_shm_buffer(const uint32_t argb) -> Buffer {
+    const auto index = entries.size();
+    if(index >= pool_slots) {
+        const auto slots = pool_slots == 0 ? size_t(16) : pool_slots * 2;
+        if(fd == -1) {
+            fd = memfd_create("towl-solid", MFD_CLOEXEC);
+            ensure(fd >= 0);
+        }
+        ensure(ftruncate(fd, slots * 4) == 0);
+        if(pool_slots == 0) {
+            pool = shm->create_shm_pool(fd, slots * 4);
+        } else {
+            pool.resize(slots * 4);
+        }
+        pool_slots = slots;
+    }
+    ensure(pwrite(fd, &argb, 4, index * 4) == 4);
+    return pool.create_buffer(index * 4, 1, 1, 4, WL_SHM_FORMAT_ARGB8888);
+}
+
+auto SolidBufferCache::get(const uint32_t argb) -> wl_buffer* {
+    for(auto& entry : entries) {
+        if(entry.argb == argb) {
+            return entry.buffer.native();
+        }
+    }
+    auto buffer = Buffer();
+    if(manager != nullptr) {
+        buffer = manager->create_buffer(argb);
+    } else if(shm != nullptr) {
+        buffer = create_shm_buffer(argb);
+    }
+    ensure(buffer.native() != nullptr);
+    return entries.emplace_back(Entry{argb, std::move(buffer)}).buffer.native();
+}
+
+auto SolidBufferCache::attach(Surface& surface, Viewport& viewport, const uint32_t argb, const int32_t width, const int32_t height) -> bool {
+    const auto buffer = get(argb);
+    ensure(buffer != nullptr);
+    surface.attach(buffer, 0, 0);
+    surface.damage(0, 0, 1, 1);
+    viewport.set_source(-1, -1, -1, -1);
+    viewport.set_destination(width, height);
+    return true;
+}
+
+auto SolidBufferCache::attach(Surface& surface, FractionalScaler& scaler, const uint32_t argb) -> bool {
+    const auto buffer = get(argb);
+    ensure(buffer != nullptr);
+    surface.attach(buffer, 0, 0);
+    surface.damage(0, 0, 1, 1);
+    scaler.get_viewport().set_source(-1, -1, -1, -1);
+    scaler.apply();
+    return true;
+}
+
+SolidBufferCache::SolidBufferCache(SinglePixelBufferManager* const manager, Shm* const shm)
+    : manager(manager),
+      shm(shm) {}
+
+SolidBufferCache::~SolidBufferCache() {
+    entries.clear();
+    pool = ShmPool();
+    if(fd >= 0) {
+        close(fd);
+    }
+}
+} // namespace towl
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+
+#include <single-pixel-buffer-v1.h>
+
+#include "compositor.hpp"
+#include "fractional-scale.hpp"
+#include "interface.hpp"
+#include "macros/autoptr.hpp"
+#include "shm.hpp"
+#include "viewporter.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativeSinglePixelBufferManager, wp_single_pixel_buffer_manager_v1, wp_single_pixel_buffer_manager_v1_destroy);
+} // namespace towl::impl
+
+namespace towl {
+class SinglePixelBufferManager : public impl::Interface {
+  private:
+    impl::AutoNativeSinglePixelBufferManager manager;
+
+  public:
+    // argb is premultiplied ARGB8888
+    auto create_buffer(uint32_t argb) -> Buffer;
+
+    SinglePixelBufferManager(void* data);
+};
+
+// version = 1
+struct SinglePixelBufferManagerBinder : impl::InterfaceBinder {
+    using Interface = SinglePixelBufferManager;
+
+    static constexpr auto interface_name = std::string_view("wp_single_pixel_buffer_manager_v1");
+
+    auto get_interface_description() -> const wl_interface* override;
+    auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
+
+    SinglePixelBufferManagerBinder(const uint32_t version)
+        : InterfaceBinder(version) {}
+};
+
+// 1x1 buffers of solid colors, stretched with a viewport
+// uses wp_single_pixel_buffer_manager_v1 if available, otherwise 1x1 shm buffers sharing one small pool
+// buffers are never written after creation, so they can be attached to any number of surfaces at once
+class SolidBufferCache {
+  private:
+    struct Entry {
+        uint32_t argb;
+        Buffer   buffer;
+    };
+
+    SinglePixelBufferManager* manager; // nullable
+    Shm*                      shm;     // nullable
+    std::vector<Entry>        entries;
+    ShmPool                   pool;
+    int                       fd         = -1;
+    size_t                    pool_slots = 0;
+
+    auto create_shm_buffer(uint32_t argb) -> Buffer;
+
+  public:
+    // argb is premultiplied ARGB8888, returns nullptr if neither backend is available
+    auto get(uint32_t argb) -> wl_buffer*;
+    // attaches a solid color covering width x height surface coordinates, commit is left to the caller
+    // a surface can have only one wp_viewport, pass the one it already uses for its other content
+    // the viewport source is reset, since a 1x1 buffer cannot satisfy a previous one
+    auto attach(Surface& surface, Viewport& viewport, uint32_t argb, int32_t width, int32_t height) -> bool;
+    // same, covering the logical size of scaler and sharing its viewport
+    auto attach(Surface& surface, FractionalScaler& scaler, uint32_t argb) -> bool;
+
+    SolidBufferCache(SolidBufferCache&) = delete;
+    SolidBufferCache(SinglePixelBufferManager* manager, Shm* shm);
+    ~SolidBufferCache();
+};
+} // namespace towl
@@ -0,0 +1,113 @@
+#pragma once
+#include <wayland-client.h>
+
+#include "interface.hpp"
+#include "output.hpp"
+
+namespace towl {
+// compile-time counterpart of Output, see static-seat.hpp
+template <class Handler>
+class StaticOutput : public impl::Interface {
+  private:
+    impl::AutoNativeOutput output;
+    Handler*               handler;
+
+    static auto geometry(void* const   data, wl_output* const /*wl_output*/,
+                         const int32_t x, const int32_t y,
+                         const int32_t physical_width, const int32_t physical_height,
+                         const int32_t     subpixel,
+                         const char* const make, const char* const model,
+                         const int32_t transform) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_geometry(self.output.get(), x, y, physical_width, physical_height, subpixel, make, model, transform); }) {
+            self.handler->on_wl_output_geometry(self.output.get(), x, y, physical_width, physical_height, subpixel, make, model, transform);
+        }
+    }
+
+    static auto mode(void* const    data, wl_output* const /*wl_output*/,
+                     const uint32_t flags,
+                     const int32_t width, const int32_t height,
+                     const int32_t refresh) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_mode(self.output.get(), flags, width, height, refresh); }) {
+            self.handler->on_wl_output_mode(self.output.get(), flags, width, height, refresh);
+        }
+    }
+
+    static auto done(void* const data, wl_output* const /*wl_output*/) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_done(self.output.get()); }) {
+            self.handler->on_wl_output_done(self.output.get());
+        }
+    }
+
+    static auto scale(void* const data, wl_output* const /*wl_output*/, const int32_t factor) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_scale(self.output.get(), factor); }) {
+            self.handler->on_wl_output_scale(self.output.get(), factor);
+        }
+    }
+
+    static auto name(void* const data, wl_output* const /*wl_output*/, const char* const name) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_name(self.output.get(), name); }) {
+            self.handler->on_wl_output_name(self.output.get(), name);
+        }
+    }
+
+    static auto description(void* const data, wl_output* const /*wl_output*/, const char* const description) -> void {
+        auto& self = *std::bit_cast<StaticOutput*>(data);
+        if constexpr(requires { self.handler->on_wl_output_description(self.output.get(), description); }) {
+            self.handler->on_wl_output_description(self.output.get(), description);
+        }
+    }
+
+    static inline wl_output_listener listener = {geometry, mode, done, scale, name, description};
+
+  public:
+    auto native() -> wl_output* {
+        return output.get();
+    }
+
+    StaticOutput(void* const data, const uint32_t version, Handler* const handler)
+        : output(std::bit_cast<wl_output*>(data), {version}),
+          handler(handler) {
+        wl_output_add_listener(output.get(), &listener, this);
+        if constexpr(requires { handler->on_wl_output_created(output.get()); }) {
+            handler->on_wl_output_created(output.get());
+        }
+    }
+
+    ~StaticOutput() override {
+        if constexpr(requires { handler->on_wl_output_removed(output.get()); }) {
+            handler->on_wl_output_removed(output.get());
+        }
+    }
+};
+
+// version = 1 ~ 4
+template <class Handler>
+struct StaticOutputBinder : impl::InterfaceBinder {
+    using Interface = StaticOutput<Handler>;
+
+    static constexpr auto interface_name = std::string_view("wl_output");
+
+    Handler* handler;
+
+    auto get_interface_description() -> const wl_interface* override {
+        return &wl_output_interface;
+    }
+
+    auto create_interface(void* const data) -> std::unique_ptr<impl::Interface> override {
+        return std::unique_ptr<impl::Interface>(new StaticOutput<Handler>(data, version, handler));
+    }
+
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data, version, handler);
+    }
+
+    StaticOutputBinder(const uint32_t version, Handler* const handler)
+        : InterfaceBinder(version),
+          handler(handler) {}
+};
+} // namespace towl
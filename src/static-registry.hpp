@@ -0,0 +1,262 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <wayland-client.h>
+
+#include "macros/assert.hpp"
+#include "registry.hpp"
+
+namespace towl::impl {
+constexpr auto hash_interface_name(const std::string_view name) -> uint32_t {
+    // fnv-1a
+    auto hash = uint32_t(2166136261u);
+    for(const auto c : name) {
+        hash = (hash ^ uint8_t(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// stable addressed storage, the first chunk is stored inline
+template <class T, size_t chunk_size = 2>
+class InterfacePool {
+  private:
+    struct Slot {
+        alignas(T) std::byte storage[sizeof(T)];
+        bool used = false;
+
+        auto get() -> T* {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    using Chunk = std::array<Slot, chunk_size>;
+
+    Chunk                               inline_chunk;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    size_t                              count = 0;
+
+    template <class Func>
+    auto for_each_slot(const Func func) -> bool {
+        for(auto& slot : inline_chunk) {
+            if(func(slot)) {
+                return true;
+            }
+        }
+        for(auto& chunk : chunks) {
+            for(auto& slot : *chunk) {
+                if(func(slot)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    auto find_free_slot() -> Slot& {
+        auto found = static_cast<Slot*>(nullptr);
+        for_each_slot([&found](Slot& slot) {
+            found = &slot;
+            return !slot.used;
+        });
+        if(found == nullptr || found->used) {
+            found = &(*chunks.emplace_back(new Chunk()))[0];
+        }
+        return *found;
+    }
+
+  public:
+    template <class... Args>
+    auto emplace(Args&&... args) -> T& {
+        auto& slot = find_free_slot();
+        new(slot.storage) T(std::forward<Args>(args)...);
+        slot.used = true;
+        count += 1;
+        return *slot.get();
+    }
+
+    auto erase(T* const ptr) -> bool {
+        return for_each_slot([this, ptr](Slot& slot) {
+            if(!slot.used || slot.get() != ptr) {
+                return false;
+            }
+            slot.get()->~T();
+            slot.used = false;
+            count -= 1;
+            return true;
+        });
+    }
+
+    auto get(size_t index) -> T* {
+        auto found = static_cast<T*>(nullptr);
+        for_each_slot([&found, &index](Slot& slot) {
+            if(!slot.used) {
+                return false;
+            }
+            if(index == 0) {
+                found = slot.get();
+                return true;
+            }
+            index -= 1;
+            return false;
+        });
+        return found;
+    }
+
+    template <class Func>
+    auto for_each(const Func func) -> void {
+        for_each_slot([&func](Slot& slot) {
+            if(slot.used) {
+                func(*slot.get());
+            }
+            return false;
+        });
+    }
+
+    auto size() const -> size_t {
+        return count;
+    }
+
+    InterfacePool() = default;
+    InterfacePool(InterfacePool&) = delete;
+
+    ~InterfacePool() {
+        for_each_slot([](Slot& slot) {
+            if(slot.used) {
+                slot.get()->~T();
+                slot.used = false;
+            }
+            return false;
+        });
+    }
+};
+} // namespace towl::impl
+
+namespace towl {
+// registry with the set of binders fixed at compile time
+// interface names are matched by precomputed hashes and bound objects are kept in per-binder pools instead of one heap allocation each
+template <class... Binders>
+class StaticRegistry {
+  private:
+    struct Entry {
+        uint32_t id;
+        uint32_t binder_index;
+        void*    object;
+    };
+
+    impl::AutoNativeRegistry                                        registry;
+    std::tuple<Binders...>                                          binders;
+    std::tuple<impl::InterfacePool<typename Binders::Interface>...> pools;
+    std::vector<Entry>                                              entries;
+
+    static auto global_callback(void* const data, wl_registry* const /*registry*/, const uint32_t id, const char* const interface, const uint32_t version) -> void {
+        auto&      self = *std::bit_cast<StaticRegistry*>(data);
+        const auto name = std::string_view(interface);
+        const auto hash = impl::hash_interface_name(name);
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (self.template try_bind<I>(hash, name, version, id) || ...);
+        }(std::index_sequence_for<Binders...>());
+    }
+
+    static auto remove_callback(void* const data, wl_registry* const /*registry*/, const uint32_t id) -> void {
+        auto& self = *std::bit_cast<StaticRegistry*>(data);
+        for(auto i = self.entries.begin(); i != self.entries.end(); i += 1) {
+            if(i->id != id) {
+                continue;
+            }
+            const auto entry = *i;
+            self.entries.erase(i);
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((entry.binder_index == I && self.template unbind<I>(entry.object)) || ...);
+            }(std::index_sequence_for<Binders...>());
+            return;
+        }
+    }
+
+    static inline wl_registry_listener listener = {global_callback, remove_callback};
+
+    // position of Binder in Binders, several binders may share an interface type
+    template <class Binder>
+    static constexpr auto index_of() -> size_t {
+        constexpr auto matches = std::array{std::is_same_v<Binder, Binders>...};
+        auto           index   = matches.size();
+        for(auto i = 0uz; i < matches.size(); i += 1) {
+            if(matches[i]) {
+                index = i;
+                break;
+            }
+        }
+        return index;
+    }
+
+    template <class Binder>
+    auto get_pool() -> auto& {
+        constexpr auto index = index_of<Binder>();
+        static_assert(index < sizeof...(Binders), "Binder is not part of this registry");
+        return std::get<index>(pools);
+    }
+
+    template <size_t I>
+    auto try_bind(const uint32_t hash, const std::string_view name, const uint32_t version, const uint32_t id) -> bool {
+        using Binder = std::tuple_element_t<I, std::tuple<Binders...>>;
+
+        constexpr auto binder_hash = impl::hash_interface_name(Binder::interface_name);
+        if(hash != binder_hash || name != Binder::interface_name) {
+            return false;
+        }
+        auto& binder = std::get<I>(binders);
+        ensure(binder.version <= version, "application requires version {} of {}, but server provides version {}.", binder.version, name, version);
+        const auto data   = wl_registry_bind(registry.get(), id, binder.get_interface_description(), binder.version);
+        auto&      pool   = std::get<I>(pools);
+        auto&      object = std::apply([&pool](auto... args) -> auto& { return pool.emplace(args...); }, binder.get_interface_args(data));
+        object.binder       = &binder;
+        object.interface_id = id;
+        entries.push_back({id, I, &object});
+        return true;
+    }
+
+    template <size_t I>
+    auto unbind(void* const object) -> bool {
+        using Binder = std::tuple_element_t<I, std::tuple<Binders...>>;
+        return std::get<I>(pools).erase(static_cast<typename Binder::Interface*>(object));
+    }
+
+  public:
+    template <class Binder>
+    auto get_binder() -> Binder& {
+        return std::get<Binder>(binders);
+    }
+
+    template <class Binder>
+    auto get(const size_t index = 0) -> typename Binder::Interface* /* nullable */ {
+        return get_pool<Binder>().get(index);
+    }
+
+    template <class Binder>
+    auto count() const -> size_t {
+        constexpr auto index = index_of<Binder>();
+        static_assert(index < sizeof...(Binders), "Binder is not part of this registry");
+        return std::get<index>(pools).size();
+    }
+
+    template <class Binder, class Func>
+    auto for_each(const Func func) -> void {
+        get_pool<Binder>().for_each(func);
+    }
+
+    StaticRegistry(StaticRegistry&) = delete;
+
+    StaticRegistry(wl_registry* const registry, Binders... binders)
+        : registry(registry),
+          binders(std::move(binders)...) {
+        wl_registry_add_listener(registry, &listener, this);
+    }
+};
+} // namespace towl
@@ -0,0 +1,368 @@
+#pragma once
+#include <optional>
+#include <utility>
+
+#include <wayland-client.h>
+
+#include "interface.hpp"
+#include "keyboard.hpp"
+#include "pointer.hpp"
+#include "seat.hpp"
+#include "touch.hpp"
+
+// compile-time counterparts of Pointer, Keyboard, Touch and Seat
+// events are dispatched directly to the Handler type, and events it does not implement are dropped at compile time
+
+namespace towl::impl {
+// satisfied by handlers implementing at least one of the events forwarded by the matching Static* class
+template <class Handler>
+concept PointerHandler = requires(Handler& h, wl_surface* s) { h.on_wl_pointer_enter(s, 0.0, 0.0); } ||
+                         requires(Handler& h, wl_surface* s) { h.on_wl_pointer_leave(s); } ||
+                         requires(Handler& h) { h.on_wl_pointer_motion(0.0, 0.0); } ||
+                         requires(Handler& h) { h.on_wl_pointer_button(0u, 0u); } ||
+                         requires(Handler& h) { h.on_wl_pointer_axis(0u, 0.0); } ||
+                         requires(Handler& h) { h.on_wl_pointer_frame(); } ||
+                         requires(Handler& h) { h.on_wl_pointer_axis_source(0u); } ||
+                         requires(Handler& h) { h.on_wl_pointer_axis_stop(0u); } ||
+                         requires(Handler& h) { h.on_wl_pointer_axis_discrete(0u, 0); } ||
+                         requires(Handler& h) { h.on_wl_pointer_axis_value120(0u, 0); } ||
+                         requires(Handler& h, const PointerFrame& f) { h.on_wl_pointer_frame(f); };
+
+template <class Handler>
+concept KeyboardHandler = requires(Handler& h) { h.on_wl_keyboard_keymap(0u, 0, 0u); } ||
+                          requires(Handler& h, wl_surface* s, const Array<uint32_t>& keys) { h.on_wl_keyboard_enter(s, keys); } ||
+                          requires(Handler& h, wl_surface* s) { h.on_wl_keyboard_leave(s); } ||
+                          requires(Handler& h) { h.on_wl_keyboard_key(0u, 0u); } ||
+                          requires(Handler& h) { h.on_wl_keyboard_modifiers(0u, 0u, 0u, 0u); } ||
+                          requires(Handler& h) { h.on_wl_keyboard_repeat_info(0, 0); };
+
+template <class Handler>
+concept TouchHandler = requires(Handler& h, wl_surface* s) { h.on_wl_touch_down(s, 0u, 0.0, 0.0); } ||
+                       requires(Handler& h) { h.on_wl_touch_motion(0u, 0.0, 0.0); } ||
+                       requires(Handler& h) { h.on_wl_touch_up(0u); } ||
+                       requires(Handler& h) { h.on_wl_touch_frame(); };
+} // namespace towl::impl
+
+namespace towl {
+template <class Handler>
+class StaticPointer {
+  private:
+    // handlers taking a PointerFrame receive one aggregated event per frame, as Pointer with PointerFrameCallbacks
+    static constexpr auto aggregate = requires(Handler& h, const PointerFrame& f) { h.on_wl_pointer_frame(f); };
+
+    impl::AutoNativePointer pointer;
+    Handler*                handler;
+    PointerFrame            pending;
+
+    auto flush_frame() -> void {
+        if constexpr(aggregate) {
+            if(pending.events == 0) {
+                return;
+            }
+            handler->on_wl_pointer_frame(std::as_const(pending));
+            pending.clear();
+        }
+    }
+
+    auto end_event() -> void {
+        if(pointer.get_deleter().version < WL_POINTER_FRAME_SINCE_VERSION) {
+            flush_frame();
+        }
+    }
+
+    static auto enter(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, wl_surface* const surface, const wl_fixed_t x, const wl_fixed_t y) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_enter(serial, surface, x, y);
+            self.end_event();
+        } else if constexpr(requires { self.handler->on_wl_pointer_enter(surface, 0.0, 0.0); }) {
+            self.handler->on_wl_pointer_enter(surface, wl_fixed_to_double(x), wl_fixed_to_double(y));
+        }
+    }
+
+    static auto leave(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, wl_surface* const surface) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_leave(serial, surface);
+            self.end_event();
+        } else if constexpr(requires { self.handler->on_wl_pointer_leave(surface); }) {
+            self.handler->on_wl_pointer_leave(surface);
+        }
+    }
+
+    static auto motion(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const wl_fixed_t x, const wl_fixed_t y) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_motion(time, x, y);
+            self.end_event();
+        } else if constexpr(requires { self.handler->on_wl_pointer_motion(0.0, 0.0); }) {
+            self.handler->on_wl_pointer_motion(wl_fixed_to_double(x), wl_fixed_to_double(y));
+        }
+    }
+
+    static auto button(void* const data, wl_pointer* const /*pointer*/, const uint32_t serial, const uint32_t time, const uint32_t button, const uint32_t state) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            if(!self.pending.record_button(serial, time, button, state)) {
+                self.flush_frame();
+                self.pending.record_button(serial, time, button, state);
+            }
+            self.end_event();
+        } else if constexpr(requires { self.handler->on_wl_pointer_button(button, state); }) {
+            self.handler->on_wl_pointer_button(button, state);
+        }
+    }
+
+    static auto axis(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const uint32_t axis, const wl_fixed_t value) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_axis(time, axis, value);
+            self.end_event();
+        } else if constexpr(requires { self.handler->on_wl_pointer_axis(axis, 0.0); }) {
+            self.handler->on_wl_pointer_axis(axis, wl_fixed_to_double(value));
+        }
+    }
+
+    static auto frame(void* const data, wl_pointer* const /*pointer*/) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.flush_frame();
+        } else if constexpr(requires { self.handler->on_wl_pointer_frame(); }) {
+            self.handler->on_wl_pointer_frame();
+        }
+    }
+
+    static auto axis_source(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis_source) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_axis_source(axis_source);
+        } else if constexpr(requires { self.handler->on_wl_pointer_axis_source(axis_source); }) {
+            self.handler->on_wl_pointer_axis_source(axis_source);
+        }
+    }
+
+    static auto axis_stop(void* const data, wl_pointer* const /*pointer*/, const uint32_t time, const uint32_t axis) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_axis_stop(time, axis);
+        } else if constexpr(requires { self.handler->on_wl_pointer_axis_stop(axis); }) {
+            self.handler->on_wl_pointer_axis_stop(axis);
+        }
+    }
+
+    static auto axis_discrete(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t discrete) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_axis_discrete(axis, discrete);
+        } else if constexpr(requires { self.handler->on_wl_pointer_axis_discrete(axis, discrete); }) {
+            self.handler->on_wl_pointer_axis_discrete(axis, discrete);
+        }
+    }
+
+    static auto axis_value120(void* const data, wl_pointer* const /*pointer*/, const uint32_t axis, const int32_t value120) -> void {
+        auto& self = *std::bit_cast<StaticPointer*>(data);
+        if constexpr(aggregate) {
+            self.pending.record_axis_value120(axis, value120);
+        } else if constexpr(requires { self.handler->on_wl_pointer_axis_value120(axis, value120); }) {
+            self.handler->on_wl_pointer_axis_value120(axis, value120);
+        }
+    }
+
+    static auto axis_relative_direction(void* /*data*/, wl_pointer* /*pointer*/, uint32_t /*axis*/, uint32_t /*direction*/) -> void {}
+
+    static inline wl_pointer_listener listener = {enter, leave, motion, button, axis, frame, axis_source, axis_stop, axis_discrete, axis_value120, axis_relative_direction};
+
+  public:
+    StaticPointer(wl_pointer* const pointer, const uint32_t version, Handler* const handler)
+        : pointer(pointer, {version}),
+          handler(handler) {
+        pending.clear();
+        wl_pointer_add_listener(pointer, &listener, this);
+    }
+};
+
+template <class Handler>
+class StaticKeyboard {
+  private:
+    impl::AutoNativeKeyboard keyboard;
+    Handler*                 handler;
+
+    static auto keymap(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t format, const int32_t fd, const uint32_t size) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_keymap(format, fd, size); }) {
+            self.handler->on_wl_keyboard_keymap(format, fd, size);
+        }
+    }
+
+    static auto enter(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, wl_surface* const surface, wl_array* const keys) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_enter(surface, Array<uint32_t>(*keys)); }) {
+            self.handler->on_wl_keyboard_enter(surface, Array<uint32_t>(*keys));
+        }
+    }
+
+    static auto leave(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, wl_surface* const surface) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_leave(surface); }) {
+            self.handler->on_wl_keyboard_leave(surface);
+        }
+    }
+
+    static auto key(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, const uint32_t /*time*/, const uint32_t key, const uint32_t state) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_key(key, state); }) {
+            self.handler->on_wl_keyboard_key(key, state);
+        }
+    }
+
+    static auto modifiers(void* const data, wl_keyboard* const /*wl_keyboard*/, const uint32_t /*serial*/, const uint32_t mods_depressed, const uint32_t mods_latched, const uint32_t mods_locked, const uint32_t group) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_modifiers(mods_depressed, mods_latched, mods_locked, group); }) {
+            self.handler->on_wl_keyboard_modifiers(mods_depressed, mods_latched, mods_locked, group);
+        }
+    }
+
+    static auto repeat_info(void* const data, wl_keyboard* const /*wl_keyboard*/, const int32_t rate, const int32_t delay) -> void {
+        auto& self = *std::bit_cast<StaticKeyboard*>(data);
+        if constexpr(requires { self.handler->on_wl_keyboard_repeat_info(rate, delay); }) {
+            self.handler->on_wl_keyboard_repeat_info(rate, delay);
+        }
+    }
+
+    static inline wl_keyboard_listener listener = {keymap, enter, leave, key, modifiers, repeat_info};
+
+  public:
+    StaticKeyboard(wl_keyboard* const keyboard, const uint32_t version, Handler* const handler)
+        : keyboard(keyboard, {version}),
+          handler(handler) {
+        wl_keyboard_add_listener(keyboard, &listener, this);
+    }
+};
+
+template <class Handler>
+class StaticTouch {
+  private:
+    impl::AutoNativeTouch touch;
+    Handler*              handler;
+
+    static auto down(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*serial*/, const uint32_t /*time*/, wl_surface* const surface, const int32_t id, const wl_fixed_t x, const wl_fixed_t y) -> void {
+        auto& self = *std::bit_cast<StaticTouch*>(data);
+        if constexpr(requires { self.handler->on_wl_touch_down(surface, uint32_t(id), 0.0, 0.0); }) {
+            self.handler->on_wl_touch_down(surface, id, wl_fixed_to_double(x), wl_fixed_to_double(y));
+        }
+    }
+
+    static auto up(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*serial*/, const uint32_t /*time*/, const int32_t id) -> void {
+        auto& self = *std::bit_cast<StaticTouch*>(data);
+        if constexpr(requires { self.handler->on_wl_touch_up(uint32_t(id)); }) {
+            self.handler->on_wl_touch_up(id);
+        }
+    }
+
+    static auto motion(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*time*/, const int32_t id, const wl_fixed_t x, const wl_fixed_t y) -> void {
+        auto& self = *std::bit_cast<StaticTouch*>(data);
+        if constexpr(requires { self.handler->on_wl_touch_motion(uint32_t(id), 0.0, 0.0); }) {
+            self.handler->on_wl_touch_motion(id, wl_fixed_to_double(x), wl_fixed_to_double(y));
+        }
+    }
+
+    static auto frame(void* const data, wl_touch* const /*wl_touch*/) -> void {
+        auto& self = *std::bit_cast<StaticTouch*>(data);
+        if constexpr(requires { self.handler->on_wl_touch_frame(); }) {
+            self.handler->on_wl_touch_frame();
+        }
+    }
+
+    static auto cancel(void* /*data*/, wl_touch* /*wl_touch*/) -> void {}
+    static auto shape(void* /*data*/, wl_touch* /*wl_touch*/, int32_t /*id*/, wl_fixed_t /*major*/, wl_fixed_t /*minor*/) -> void {}
+    static auto orientation(void* /*data*/, wl_touch* /*wl_touch*/, int32_t /*id*/, wl_fixed_t /*orientation*/) -> void {}
+
+    static inline wl_touch_listener listener = {down, up, motion, frame, cancel, shape, orientation};
+
+  public:
+    StaticTouch(wl_touch* const touch, const uint32_t version, Handler* const handler)
+        : touch(touch, {version}),
+          handler(handler) {
+        wl_touch_add_listener(touch, &listener, this);
+    }
+};
+
+// devices are created only for the event families the Handler implements
+template <class Handler>
+class StaticSeat : public impl::Interface {
+  private:
+    impl::AutoNativeSeat                   seat;
+    std::optional<StaticKeyboard<Handler>> keyboard;
+    std::optional<StaticPointer<Handler>>  pointer;
+    std::optional<StaticTouch<Handler>>    touch;
+    uint32_t                               version;
+    Handler*                               handler;
+
+    static auto capabilities(void* const data, wl_seat* const /*seat*/, const uint32_t cap) -> void {
+        auto& self = *std::bit_cast<StaticSeat*>(data);
+        if constexpr(impl::KeyboardHandler<Handler>) {
+            if(cap & WL_SEAT_CAPABILITY_KEYBOARD) {
+                self.keyboard.emplace(wl_seat_get_keyboard(self.seat.get()), self.version, self.handler);
+            } else {
+                self.keyboard.reset();
+            }
+        }
+        if constexpr(impl::PointerHandler<Handler>) {
+            if(cap & WL_SEAT_CAPABILITY_POINTER) {
+                self.pointer.emplace(wl_seat_get_pointer(self.seat.get()), self.version, self.handler);
+            } else {
+                self.pointer.reset();
+            }
+        }
+        if constexpr(impl::TouchHandler<Handler>) {
+            if(cap & WL_SEAT_CAPABILITY_TOUCH) {
+                self.touch.emplace(wl_seat_get_touch(self.seat.get()), self.version, self.handler);
+            } else {
+                self.touch.reset();
+            }
+        }
+    }
+
+    static auto name(void* const /*data*/, wl_seat* const /*wl_seat*/, const char* const /*name*/) -> void {}
+
+    static inline wl_seat_listener listener = {capabilities, name};
+
+  public:
+    auto native() -> wl_seat* {
+        return seat.get();
+    }
+
+    StaticSeat(void* const data, const uint32_t version, Handler* const handler)
+        : seat(std::bit_cast<wl_seat*>(data), {version}),
+          version(version),
+          handler(handler) {
+        wl_seat_add_listener(seat.get(), &listener, this);
+    }
+};
+
+// version = 1 ~ 8
+template <class Handler>
+struct StaticSeatBinder : impl::InterfaceBinder {
+    using Interface = StaticSeat<Handler>;
+
+    static constexpr auto interface_name = std::string_view("wl_seat");
+
+    Handler* handler;
+
+    auto get_interface_description() -> const wl_interface* override {
+        return &wl_seat_interface;
+    }
+
+    auto create_interface(void* const data) -> std::unique_ptr<impl::Interface> override {
+        return std::unique_ptr<impl::Interface>(new StaticSeat<Handler>(data, version, handler));
+    }
+
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data, version, handler);
+    }
+
+    StaticSeatBinder(const uint32_t version, Handler* const handler)
+        : InterfaceBinder(version),
+          handler(handler) {}
+};
+} // namespace towl
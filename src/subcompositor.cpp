@@ -0,0 +1,46 @@
+#include "subcompositor.hpp"
+
+namespace towl {
+auto Subsurface::native() -> wl_subsurface* {
+    return subsurface.get();
+}
+
+auto Subsurface::set_position(const int32_t x, const int32_t y) -> void {
+    wl_subsurface_set_position(subsurface.get(), x, y);
+}
+
+auto Subsurface::place_above(Surface& sibling) -> void {
+    wl_subsurface_place_above(subsurface.get(), sibling.native());
+}
+
+auto Subsurface::place_below(Surface& sibling) -> void {
+    wl_subsurface_place_below(subsurface.get(), sibling.native());
+}
+
+auto Subsurface::set_sync() -> void {
+    wl_subsurface_set_sync(subsurface.get());
+}
+
+auto Subsurface::set_desync() -> void {
+    wl_subsurface_set_desync(subsurface.get());
+}
+
+Subsurface::Subsurface(wl_subsurface* const subsurface)
+    : subsurface(subsurface) {
+}
+
+auto Subcompositor::get_subsurface(Surface& surface, Surface& parent) -> Subsurface {
+    return {wl_subcompositor_get_subsurface(subcompositor.get(), surface.native(), parent.native())};
+}
+
+Subcompositor::Subcompositor(void* const data)
+    : subcompositor(std::bit_cast<wl_subcompositor*>(data)) {}
+
+auto SubcompositorBinder::get_interface_description() -> const wl_interface* {
+    return &wl_subcompositor_interface;
+}
+
+auto SubcompositorBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
+    return std::unique_ptr<impl::Interface>(new Subcompositor(data));
+}
+} // namespace towl
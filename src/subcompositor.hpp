@@ -0,0 +1,58 @@
+#pragma once
+#include <wayland-client.h>
+
+#include "compositor.hpp"
+#include "interface.hpp"
+#include "macros/autoptr.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativeSubcompositor, wl_subcompositor, wl_subcompositor_destroy);
+declare_autoptr(NativeSubsurface, wl_subsurface, wl_subsurface_destroy);
+} // namespace towl::impl
+
+namespace towl {
+// position and stacking are double-buffered and applied on the parent commit
+class Subsurface {
+  private:
+    impl::AutoNativeSubsurface subsurface;
+
+  public:
+    auto native() -> wl_subsurface*;
+    auto set_position(int32_t x, int32_t y) -> void;
+    auto place_above(Surface& sibling) -> void;
+    auto place_below(Surface& sibling) -> void;
+    // in sync mode(default), commits of the surface are cached until the parent commits
+    auto set_sync() -> void;
+    // in desync mode, the surface can update at its own rate without touching the parent
+    auto set_desync() -> void;
+
+    Subsurface() = default;
+    Subsurface(wl_subsurface* subsurface);
+};
+
+class Subcompositor : public impl::Interface {
+  private:
+    impl::AutoNativeSubcompositor subcompositor;
+
+  public:
+    auto get_subsurface(Surface& surface, Surface& parent) -> Subsurface;
+
+    Subcompositor(void* data);
+};
+
+// version = 1
+struct SubcompositorBinder : impl::InterfaceBinder {
+    using Interface = Subcompositor;
+
+    static constexpr auto interface_name = std::string_view("wl_subcompositor");
+
+    auto get_interface_description() -> const wl_interface* override;
+    auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
+
+    SubcompositorBinder(const uint32_t version)
+        : InterfaceBinder(version) {}
+};
+} // namespace towl
@@ -1,4 +1,5 @@
 #include "touch.hpp"
+#include "trace.hpp"
 
 namespace towl::impl {
 auto AutoNativeTouchDeleter::operator()(wl_touch* const touch) -> void {
@@ -12,21 +13,25 @@ auto AutoNativeTouchDeleter::operator()(wl_touch* const touch) -> void {
 
 namespace towl {
 auto Touch::down(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*serial*/, const uint32_t /*time*/, wl_surface* const surface, const int32_t id, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    TOWL_TRACE_SCOPE("wl_touch.down");
     auto& self = *std::bit_cast<Touch*>(data);
     self.callbacks->on_wl_touch_down(surface, id, wl_fixed_to_double(x), wl_fixed_to_double(y));
 }
 
 auto Touch::up(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*serial*/, const uint32_t /*time*/, const int32_t id) -> void {
+    TOWL_TRACE_SCOPE("wl_touch.up");
     auto& self = *std::bit_cast<Touch*>(data);
     self.callbacks->on_wl_touch_up(id);
 }
 
 auto Touch::motion(void* const data, wl_touch* const /*wl_touch*/, const uint32_t /*time*/, const int32_t id, const wl_fixed_t x, const wl_fixed_t y) -> void {
+    TOWL_TRACE_SCOPE("wl_touch.motion");
     auto& self = *std::bit_cast<Touch*>(data);
     self.callbacks->on_wl_touch_motion(id, wl_fixed_to_double(x), wl_fixed_to_double(y));
 }
 
 auto Touch::frame(void* const data, wl_touch* const /*wl_touch*/) -> void {
+    TOWL_TRACE_SCOPE("wl_touch.frame");
     auto& self = *std::bit_cast<Touch*>(data);
     self.callbacks->on_wl_touch_frame();
 }
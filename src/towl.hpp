@@ -1,12 +1,30 @@
 #pragma once
 #include "display.hpp"
+#include "event-queue.hpp"
 #include "registry.hpp"
+#include "static-registry.hpp"
 
+#include "commit-batch.hpp"
 #include "compositor.hpp"
+#include "damage.hpp"
+#include "event-stream.hpp"
+#include "fractional-scale.hpp"
+#include "frame-scheduler.hpp"
 #include "output.hpp"
+#include "presentation.hpp"
+#include "recorder.hpp"
 #include "seat.hpp"
+#include "static-output.hpp"
+#include "static-seat.hpp"
 #include "shell.hpp"
+#include "shm-canvas.hpp"
+#include "shm-swapchain.hpp"
 #include "shm.hpp"
+#include "single-pixel-buffer.hpp"
+#include "subcompositor.hpp"
+#include "trace.hpp"
+#include "transform.hpp"
+#include "viewporter.hpp"
 #include "xdg-wm-base.hpp"
 
 #include "layer-shell.hpp"
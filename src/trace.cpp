@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+
+#include <unistd.h>
+
+#include "macros/assert.hpp"
+#include "trace.hpp"
+
+namespace towl::trace {
+namespace {
+struct Rings {
+    std::mutex                              lock;
+    std::vector<std::shared_ptr<TraceRing>> rings; // kept after their threads exit so that their events can still be exported
+    size_t                                  capacity = 16384;
+};
+
+auto get_rings() -> Rings& {
+    static auto rings = Rings();
+    return rings;
+}
+
+// escapes the few characters that can appear in names
+auto write_string(FILE* const file, const char* str) -> void {
+    fputc('"', file);
+    for(; *str != '\0'; str += 1) {
+        if(*str == '"' || *str == '\\') {
+            fputc('\\', file);
+        }
+        fputc(*str, file);
+    }
+    fputc('"', file);
+}
+} // namespace
+
+auto TraceRing::push(const TraceEvent& event) -> void {
+    const auto pos = head.load(std::memory_order_relaxed);
+    if(pos - tail.load(std::memory_order_acquire) > mask) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    events[pos & mask] = event;
+    head.store(pos + 1, std::memory_order_release);
+}
+
+auto TraceRing::get_dropped_count() const -> size_t {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+TraceRing::TraceRing(const size_t capacity, const uint32_t tid)
+    : events(std::bit_ceil(capacity)),
+      mask(events.size() - 1),
+      tid(tid) {}
+
+auto now() -> uint64_t {
+    auto ts = timespec();
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+auto get_thread_ring() -> TraceRing& {
+    thread_local auto ring = [] {
+        auto&       rings = get_rings();
+        const auto  lock  = std::lock_guard(rings.lock);
+        const auto& ring  = rings.rings.emplace_back(new TraceRing(rings.capacity, gettid()));
+        return ring;
+    }();
+    return *ring;
+}
+
+auto record_instant(const char* const name, const uint64_t arg) -> void {
+    get_thread_ring().push({name, now(), 0, arg, TraceEvent::Type::Instant});
+}
+
+auto write_chrome_json(const char* const path) -> bool {
+    const auto file = fopen(path, "w");
+    ensure(file != nullptr, "failed to open {}", path);
+    const auto pid = getpid();
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+    auto  first = true;
+    auto& rings = get_rings();
+    {
+        const auto lock = std::lock_guard(rings.lock);
+        for(const auto& ring : rings.rings) {
+            ring->drain([&](const TraceEvent& event) {
+                fputs(first ? "\n" : ",\n", file);
+                first = false;
+                fputs("{\"name\":", file);
+                write_string(file, event.name);
+                // chrome traces use microseconds
+                fprintf(file, ",\"pid\":%d,\"tid\":%u,\"ts\":%.3f", pid, ring->tid, event.begin / 1000.0);
+                switch(event.type) {
+                case TraceEvent::Type::Complete:
+                    fprintf(file, ",\"ph\":\"X\",\"dur\":%.3f", event.duration / 1000.0);
+                    break;
+                case TraceEvent::Type::Instant:
+                    fputs(",\"ph\":\"i\",\"s\":\"t\"", file);
+                    break;
+                }
+                fprintf(file, ",\"args\":{\"value\":%llu}}", (unsigned long long)event.arg);
+            });
+            if(const auto dropped = ring->get_dropped_count(); dropped != 0) {
+                fputs(first ? "\n" : ",\n", file);
+                first = false;
+                fprintf(file, "{\"name\":\"dropped events\",\"ph\":\"C\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"args\":{\"count\":%zu}}", pid, ring->tid, now() / 1000.0, dropped);
+            }
+        }
+    }
+    fputs("\n]}\n", file);
+    const auto error = ferror(file) != 0;
+    ensure(fclose(file) == 0 && !error, "failed to write {}", path);
+    return true;
+}
+
+auto set_ring_capacity(const size_t capacity) -> void {
+    auto&      rings = get_rings();
+    const auto lock  = std::lock_guard(rings.lock);
+    rings.capacity   = std::max(capacity, size_t(2));
+}
+} // namespace towl::trace
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace towl::trace {
+// names must be string literals, only the pointer is stored
+struct TraceEvent {
+    enum class Type : uint8_t {
+        Complete,
+        Instant,
+    };
+
+    const char* name;
+    uint64_t    begin; // nanoseconds, CLOCK_MONOTONIC
+    uint64_t    duration;
+    uint64_t    arg;
+    Type        type;
+};
+
+// single producer single consumer ring owned by one thread
+// events are dropped when the exporter falls behind
+class TraceRing {
+  private:
+    std::vector<TraceEvent> events;
+    size_t                  mask;
+    std::atomic_size_t      head    = 0; // written by the producer
+    std::atomic_size_t      tail    = 0; // written by the consumer
+    std::atomic_size_t      dropped = 0;
+
+  public:
+    uint32_t tid;
+
+    auto push(const TraceEvent& event) -> void;
+    // calls func for every pending event, in order
+    template <class Func>
+    auto drain(const Func func) -> void {
+        const auto end = head.load(std::memory_order_acquire);
+        auto       pos = tail.load(std::memory_order_relaxed);
+        for(; pos != end; pos += 1) {
+            func(events[pos & mask]);
+        }
+        tail.store(pos, std::memory_order_release);
+    }
+    auto get_dropped_count() const -> size_t;
+
+    TraceRing(size_t capacity, uint32_t tid);
+};
+
+auto now() -> uint64_t;
+// ring of the calling thread, registered on first use
+auto get_thread_ring() -> TraceRing&;
+auto record_instant(const char* name, uint64_t arg = 0) -> void;
+// drains every thread's ring into a Chrome trace event JSON file, which Perfetto also reads
+// events drained here are not exported again
+auto write_chrome_json(const char* path) -> bool;
+// capacity of rings created after this call, rounded up to a power of two
+auto set_ring_capacity(size_t capacity) -> void;
+
+class TraceScope {
+  private:
+    const char* name;
+    uint64_t    begin;
+    uint64_t    arg = 0;
+
+  public:
+    auto set_arg(const uint64_t value) -> void {
+        arg = value;
+    }
+
+    TraceScope(const char* const name)
+        : name(name),
+          begin(now()) {}
+
+    ~TraceScope() {
+        get_thread_ring().push({name, begin, now() - begin, arg, TraceEvent::Type::Complete});
+    }
+};
+} // namespace towl::trace
+
+// instrumentation points, compiled out unless TOWL_TRACING is defined
+#if defined(TOWL_TRACING)
+#define TOWL_TRACE_CONCAT_(a, b) a##b
+#define TOWL_TRACE_CONCAT(a, b)  TOWL_TRACE_CONCAT_(a, b)
+#define TOWL_TRACE_SCOPE(name)   const auto TOWL_TRACE_CONCAT(towl_trace_scope_, __LINE__) = towl::trace::TraceScope(name)
+#define TOWL_TRACE_INSTANT(name, arg) towl::trace::record_instant(name, arg)
+#else
+#define TOWL_TRACE_SCOPE(name)
+#define TOWL_TRACE_INSTANT(name, arg)
+#endif
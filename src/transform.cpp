@@ -0,0 +1,62 @@
+#include <algorithm>
+
+#include "transform.hpp"
+
+namespace towl {
+auto get_transformed_size(const uint32_t transform, const int32_t width, const int32_t height) -> std::pair<int32_t, int32_t> {
+    // odd transforms rotate by 90 or 270 degrees
+    return transform & 1 ? std::pair{height, width} : std::pair{width, height};
+}
+
+auto surface_to_buffer(const uint32_t transform, const int32_t width, const int32_t height, const double x, const double y) -> std::pair<double, double> {
+    switch(transform) {
+    case WL_OUTPUT_TRANSFORM_NORMAL:
+    default:
+        return {x, y};
+    case WL_OUTPUT_TRANSFORM_90:
+        return {y, width - x};
+    case WL_OUTPUT_TRANSFORM_180:
+        return {width - x, height - y};
+    case WL_OUTPUT_TRANSFORM_270:
+        return {height - y, x};
+    case WL_OUTPUT_TRANSFORM_FLIPPED:
+        return {width - x, y};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_90:
+        return {y, x};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_180:
+        return {x, height - y};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_270:
+        return {height - y, width - x};
+    }
+}
+
+auto buffer_to_surface(const uint32_t transform, const int32_t width, const int32_t height, const double x, const double y) -> std::pair<double, double> {
+    switch(transform) {
+    case WL_OUTPUT_TRANSFORM_NORMAL:
+    default:
+        return {x, y};
+    case WL_OUTPUT_TRANSFORM_90:
+        return {width - y, x};
+    case WL_OUTPUT_TRANSFORM_180:
+        return {width - x, height - y};
+    case WL_OUTPUT_TRANSFORM_270:
+        return {y, height - x};
+    case WL_OUTPUT_TRANSFORM_FLIPPED:
+        return {width - x, y};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_90:
+        return {y, x};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_180:
+        return {x, height - y};
+    case WL_OUTPUT_TRANSFORM_FLIPPED_270:
+        return {width - y, height - x};
+    }
+}
+
+auto surface_to_buffer(const uint32_t transform, const int32_t width, const int32_t height, const Rect& rect) -> Rect {
+    const auto [x1, y1] = surface_to_buffer(transform, width, height, rect.x, rect.y);
+    const auto [x2, y2] = surface_to_buffer(transform, width, height, rect.x + rect.width, rect.y + rect.height);
+    const auto left     = int32_t(std::min(x1, x2));
+    const auto top      = int32_t(std::min(y1, y2));
+    return {left, top, int32_t(std::max(x1, x2)) - left, int32_t(std::max(y1, y2)) - top};
+}
+} // namespace towl
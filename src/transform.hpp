@@ -0,0 +1,19 @@
+#pragma once
+#include <utility>
+
+#include <wayland-client.h>
+
+#include "damage.hpp"
+
+// coordinate mapping for wl_surface.set_buffer_transform
+// transform is a wl_output_transform, width and height are the surface size
+// a buffer with transform applied is get_transformed_size() large and can be scanned out without rotation by the compositor
+
+namespace towl {
+auto get_transformed_size(uint32_t transform, int32_t width, int32_t height) -> std::pair<int32_t, int32_t>;
+// continuous coordinates, e.g. pointer positions
+auto surface_to_buffer(uint32_t transform, int32_t width, int32_t height, double x, double y) -> std::pair<double, double>;
+auto buffer_to_surface(uint32_t transform, int32_t width, int32_t height, double x, double y) -> std::pair<double, double>;
+// pixel rectangles, e.g. damage
+auto surface_to_buffer(uint32_t transform, int32_t width, int32_t height, const Rect& rect) -> Rect;
+} // namespace towl
@@ -0,0 +1,39 @@
+#include "viewporter.hpp"
+
+namespace towl {
+auto Viewport::native() -> wp_viewport* {
+    return viewport.get();
+}
+
+auto Viewport::set_source(const double x, const double y, const double width, const double height) -> void {
+    if(x < 0 || y < 0 || width < 0 || height < 0) {
+        const auto unset = wl_fixed_from_int(-1);
+        wp_viewport_set_source(viewport.get(), unset, unset, unset, unset);
+        return;
+    }
+    wp_viewport_set_source(viewport.get(), wl_fixed_from_double(x), wl_fixed_from_double(y), wl_fixed_from_double(width), wl_fixed_from_double(height));
+}
+
+auto Viewport::set_destination(const int32_t width, const int32_t height) -> void {
+    wp_viewport_set_destination(viewport.get(), width, height);
+}
+
+Viewport::Viewport(wp_viewport* const viewport)
+    : viewport(viewport) {
+}
+
+auto Viewporter::get_viewport(Surface& surface) -> Viewport {
+    return {wp_viewporter_get_viewport(viewporter.get(), surface.native())};
+}
+
+Viewporter::Viewporter(void* const data)
+    : viewporter(std::bit_cast<wp_viewporter*>(data)) {}
+
+auto ViewporterBinder::get_interface_description() -> const wl_interface* {
+    return &wp_viewporter_interface;
+}
+
+auto ViewporterBinder::create_interface(void* const data) -> std::unique_ptr<impl::Interface> {
+    return std::unique_ptr<impl::Interface>(new Viewporter(data));
+}
+} // namespace towl
@@ -0,0 +1,55 @@
+#pragma once
+#include <viewporter.h>
+
+#include "compositor.hpp"
+#include "interface.hpp"
+#include "macros/autoptr.hpp"
+
+namespace towl::impl {
+declare_autoptr(NativeViewporter, wp_viewporter, wp_viewporter_destroy);
+declare_autoptr(NativeViewport, wp_viewport, wp_viewport_destroy);
+} // namespace towl::impl
+
+namespace towl {
+// crop and scale state of a surface, applied on the next commit
+class Viewport {
+  private:
+    impl::AutoNativeViewport viewport;
+
+  public:
+    auto native() -> wp_viewport*;
+    // in buffer coordinates after buffer_transform and buffer_scale, negative values unset the source
+    auto set_source(double x, double y, double width, double height) -> void;
+    // surface size regardless of the buffer size, -1 unsets the destination
+    auto set_destination(int32_t width, int32_t height) -> void;
+
+    Viewport() = default;
+    Viewport(wp_viewport* viewport);
+};
+
+class Viewporter : public impl::Interface {
+  private:
+    impl::AutoNativeViewporter viewporter;
+
+  public:
+    auto get_viewport(Surface& surface) -> Viewport;
+
+    Viewporter(void* data);
+};
+
+// version = 1
+struct ViewporterBinder : impl::InterfaceBinder {
+    using Interface = Viewporter;
+
+    static constexpr auto interface_name = std::string_view("wp_viewporter");
+
+    auto get_interface_description() -> const wl_interface* override;
+    auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
+
+    ViewporterBinder(const uint32_t version)
+        : InterfaceBinder(version) {}
+};
+} // namespace towl
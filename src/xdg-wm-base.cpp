@@ -1,10 +1,28 @@
 #include "xdg-wm-base.hpp"
 #include "macros/assert.hpp"
+#include "trace.hpp"
 
 namespace towl {
-auto XDGToplevel::configure(void* const data, xdg_toplevel* const /*toplevel*/, const int32_t width, const int32_t height, wl_array* const /*states*/) -> void {
+auto XDGToplevelCallbacks::on_xdg_toplevel_configure(const XDGToplevelState& state) -> void {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    on_xdg_toplevel_configure(state.width, state.height);
+#pragma GCC diagnostic pop
+}
+
+auto XDGToplevel::configure(void* const data, xdg_toplevel* const /*toplevel*/, const int32_t width, const int32_t height, wl_array* const states) -> void {
     auto& self = *std::bit_cast<XDGToplevel*>(data);
-    self.callbacks->on_xdg_toplevel_configure(width, height);
+
+    self.pending.width  = width;
+    self.pending.height = height;
+    self.pending.states = 0;
+
+    const auto array = Array<uint32_t>(*states);
+    for(auto i = 0uz; i < array.size; i += 1) {
+        if(array.data[i] < 32) {
+            self.pending.states |= 1u << array.data[i];
+        }
+    }
 }
 
 auto XDGToplevel::close(void* const data, xdg_toplevel* const /*toplevel*/) -> void {
@@ -12,10 +30,28 @@ auto XDGToplevel::close(void* const data, xdg_toplevel* const /*toplevel*/) -> v
     self.callbacks->on_xdg_toplevel_close();
 }
 
+auto XDGToplevel::bounds(void* const data, xdg_toplevel* const /*toplevel*/, const int32_t width, const int32_t height) -> void {
+    auto& self = *std::bit_cast<XDGToplevel*>(data);
+
+    self.pending.bounds_width  = width;
+    self.pending.bounds_height = height;
+}
+
 auto XDGToplevel::set_title(const char* const title) -> void {
     xdg_toplevel_set_title(toplevel.get(), title);
 }
 
+auto XDGToplevel::get_state() const -> const XDGToplevelState& {
+    return current;
+}
+
+auto XDGToplevel::apply_pending() -> void {
+    current = pending;
+    if(callbacks != nullptr) {
+        callbacks->on_xdg_toplevel_configure(current);
+    }
+}
+
 auto XDGToplevel::init(XDGToplevelCallbacks* const callbacks) -> bool {
     ensure(toplevel != NULL);
     this->callbacks = callbacks;
@@ -27,14 +63,43 @@ XDGToplevel::XDGToplevel(xdg_toplevel* const toplevel)
     : toplevel(toplevel) {
 }
 
-auto XDGSurface::configure(void* const data, xdg_surface* const surface, const uint32_t serial) -> void {
-    xdg_surface_ack_configure(surface, serial);
+auto XDGSurface::configure(void* const data, xdg_surface* const /*surface*/, const uint32_t serial) -> void {
+    TOWL_TRACE_SCOPE("xdg_surface.configure");
     auto& self = *std::bit_cast<XDGSurface*>(data);
+    if(self.toplevel) {
+        self.toplevel->apply_pending();
+        if(self.base_surface != nullptr) {
+            self.base_surface->set_suspended(self.toplevel->get_state().has(XDG_TOPLEVEL_STATE_SUSPENDED));
+        }
+    }
+    self.serial  = serial;
+    self.unacked = true;
+    if(self.auto_ack) {
+        self.ack_configure();
+    }
     self.callbacks->on_xdg_surface_configure();
 }
 
-auto XDGSurface::create_xdg_toplevel() -> XDGToplevel {
-    return XDGToplevel(xdg_surface_get_toplevel(surface.get()));
+auto XDGSurface::create_xdg_toplevel() -> XDGToplevel& {
+    return toplevel.emplace(xdg_surface_get_toplevel(surface.get()));
+}
+
+auto XDGSurface::set_auto_ack(const bool flag) -> void {
+    auto_ack = flag;
+}
+
+auto XDGSurface::ack_configure() -> bool {
+    if(!unacked) {
+        return false;
+    }
+    TOWL_TRACE_INSTANT("xdg_surface.ack_configure", serial);
+    xdg_surface_ack_configure(surface.get(), serial);
+    unacked = false;
+    return true;
+}
+
+auto XDGSurface::is_configure_pending() const -> bool {
+    return unacked;
 }
 
 auto XDGSurface::init(XDGSurfaceCallbacks* callbacks) -> bool {
@@ -44,8 +109,9 @@ auto XDGSurface::init(XDGSurfaceCallbacks* callbacks) -> bool {
     return true;
 }
 
-XDGSurface::XDGSurface(xdg_surface* const surface)
-    : surface(surface) {
+XDGSurface::XDGSurface(xdg_surface* const surface, Surface* const base_surface)
+    : surface(surface),
+      base_surface(base_surface) {
 }
 
 auto XDGWMBase::ping(void* const /*data*/, xdg_wm_base* const wm_base, const uint32_t serial) -> void {
@@ -56,6 +122,15 @@ auto XDGWMBase::create_xdg_surface(wl_surface* const surface) -> XDGSurface {
     return {xdg_wm_base_get_xdg_surface(wm_base.get(), surface)};
 }
 
+auto XDGWMBase::create_xdg_surface(wl_surface* const surface, EventQueue& queue) -> XDGSurface {
+    const auto wrapper = queue.wrap(wm_base.get());
+    return {xdg_wm_base_get_xdg_surface(wrapper.get(), surface)};
+}
+
+auto XDGWMBase::create_xdg_surface(Surface& surface) -> XDGSurface {
+    return {xdg_wm_base_get_xdg_surface(wm_base.get(), surface.native()), &surface};
+}
+
 XDGWMBase::XDGWMBase(void* const data)
     : wm_base(std::bit_cast<xdg_wm_base*>(data)) {}
 
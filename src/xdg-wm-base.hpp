@@ -1,6 +1,12 @@
 #pragma once
+#include <optional>
+
 #include <xdg-shell.h>
 
+#include "array.hpp"
+#include "compositor.hpp"
+
+#include "event-queue.hpp"
 #include "interface.hpp"
 #include "macros/autoptr.hpp"
 
@@ -11,8 +17,24 @@ declare_autoptr(NativeXDGWMBase, xdg_wm_base, xdg_wm_base_destroy);
 } // namespace towl::impl
 
 namespace towl {
+struct XDGToplevelState {
+    int32_t  width         = 0; // 0 means the client decides
+    int32_t  height        = 0;
+    uint32_t states        = 0; // bitset of 1 << xdg_toplevel_state
+    int32_t  bounds_width  = 0;
+    int32_t  bounds_height = 0;
+
+    auto has(const xdg_toplevel_state state) const -> bool {
+        return states & (1u << state);
+    }
+};
+
 class XDGToplevelCallbacks {
   public:
+    // called once per xdg_surface.configure with the state it applied
+    // the default implementation forwards the size to the deprecated overload below
+    virtual auto on_xdg_toplevel_configure(const XDGToplevelState& state) -> void;
+    [[deprecated("override on_xdg_toplevel_configure(const XDGToplevelState&) instead")]]
     virtual auto on_xdg_toplevel_configure(int /*width*/, int /*height*/) -> void {}
     virtual auto on_xdg_toplevel_close() -> void {}
     virtual ~XDGToplevelCallbacks() {}
@@ -20,18 +42,27 @@ class XDGToplevelCallbacks {
 
 class XDGToplevel {
   private:
+    friend class XDGSurface;
+
     impl::AutoNativeXDGToplevel toplevel;
-    XDGToplevelCallbacks*       callbacks;
+    XDGToplevelCallbacks*       callbacks = nullptr;
+    XDGToplevelState            pending;
+    XDGToplevelState            current;
+
+    // promotes the pending state and reports it, called by XDGSurface on configure
+    auto apply_pending() -> void;
 
     static auto configure(void* data, xdg_toplevel* toplevel, int32_t width, int32_t height, wl_array* states) -> void;
     static auto close(void* data, xdg_toplevel* toplevel) -> void;
-    static auto bounds(void* const /*data*/, xdg_toplevel* const /*toplevel*/, const int32_t /*width*/, const int32_t /*height*/) -> void {}
+    static auto bounds(void* data, xdg_toplevel* toplevel, int32_t width, int32_t height) -> void;
     static auto capabilities(void* const /*data*/, xdg_toplevel* const /*toplevel*/, wl_array* const /*capabilities*/) -> void {};
 
     static inline xdg_toplevel_listener listener = {configure, close, bounds, capabilities};
 
   public:
     auto set_title(const char* title) -> void;
+    // state of the latest xdg_surface.configure
+    auto get_state() const -> const XDGToplevelState&;
     auto init(XDGToplevelCallbacks* callbacks) -> bool;
 
     XDGToplevel() = default;
@@ -47,17 +78,29 @@ class XDGSurface {
   private:
     impl::AutoNativeXDGSurface surface;
     XDGSurfaceCallbacks*       callbacks;
+    std::optional<XDGToplevel> toplevel;
+    Surface*                   base_surface = nullptr;
+    uint32_t                   serial       = 0;
+    bool                       unacked      = false;
+    bool                       auto_ack     = true;
 
     static auto configure(void* data, xdg_surface* surface, uint32_t serial) -> void;
 
     static inline xdg_surface_listener listener = {configure};
 
   public:
-    auto create_xdg_toplevel() -> XDGToplevel;
+    // the toplevel is owned by this surface, its state is applied atomically on every configure
+    auto create_xdg_toplevel() -> XDGToplevel&;
+    // when disabled, configures are only acknowledged by ack_configure()
+    // so that the application can ack once, right before committing a buffer matching the latest configure
+    auto set_auto_ack(bool flag) -> void;
+    // acknowledges the latest configure, intermediate ones are skipped
+    auto ack_configure() -> bool;
+    auto is_configure_pending() const -> bool;
     auto init(XDGSurfaceCallbacks* callbacks) -> bool;
 
     XDGSurface() = default;
-    XDGSurface(xdg_surface* const surface);
+    XDGSurface(xdg_surface* const surface, Surface* base_surface = nullptr);
 };
 
 class XDGWMBase : public impl::Interface {
@@ -70,14 +113,25 @@ class XDGWMBase : public impl::Interface {
 
   public:
     auto create_xdg_surface(wl_surface* const surface) -> XDGSurface;
+    // the xdg_surface and its toplevel are dispatched on queue
+    auto create_xdg_surface(wl_surface* const surface, EventQueue& queue) -> XDGSurface;
+    // the surface is told when the toplevel gets suspended, see Surface::is_visible
+    auto create_xdg_surface(Surface& surface) -> XDGSurface;
 
     XDGWMBase(void* data);
 };
 
-// version = 1 ~ 5
+// version = 1 ~ 6
 struct XDGWMBaseBinder : impl::InterfaceBinder {
+    using Interface = XDGWMBase;
+
+    static constexpr auto interface_name = std::string_view("xdg_wm_base");
+
     auto get_interface_description() -> const wl_interface* override;
     auto create_interface(void* data) -> std::unique_ptr<impl::Interface> override;
+    auto get_interface_args(void* const data) const {
+        return std::tuple(data);
+    }
 
     XDGWMBaseBinder(const uint32_t version)
         : InterfaceBinder(version) {}
@@ -0,0 +1,227 @@
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "macros/assert.hpp"
+#include "trace.hpp"
+#include "xkb-keyboard.hpp"
+
+namespace towl {
+namespace {
+// WL_KEYBOARD_KEY_STATE_REPEATED, since version 10, missing in older headers
+constexpr auto key_state_repeated = uint32_t(2);
+
+// lets the cache be searched with a view of the mapping, without copying it
+struct TextHash {
+    using is_transparent = void;
+
+    auto operator()(const std::string_view text) const -> size_t {
+        return std::hash<std::string_view>()(text);
+    }
+};
+
+struct KeymapCache {
+    std::mutex                                                                                      lock;
+    std::unordered_map<std::string, std::shared_ptr<impl::XKBKeymapJob>, TextHash, std::equal_to<>> jobs; // keyed by keymap text
+};
+
+auto get_cache() -> KeymapCache& {
+    static auto cache = KeymapCache();
+    return cache;
+}
+
+// runs on a worker thread, takes ownership of the mapping and the fd
+auto compile_keymap(const std::shared_ptr<impl::XKBKeymapJob> job, void* const map, const size_t size, const std::string_view text, const int fd) -> void {
+    TOWL_TRACE_SCOPE("xkb.compile_keymap");
+    // each compilation gets its own context, contexts are not thread safe
+    if(const auto context = xkb_context_new(XKB_CONTEXT_NO_DEFAULT_INCLUDES | XKB_CONTEXT_NO_ENVIRONMENT_NAMES); context != nullptr) {
+        const auto keymap = xkb_keymap_new_from_buffer(context, text.data(), text.size(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+        if(keymap != nullptr) {
+            job->keymap.reset(keymap, xkb_keymap_unref);
+        }
+        xkb_context_unref(context);
+    }
+    munmap(map, size);
+    close(fd);
+    const auto lock = std::lock_guard(job->lock);
+    job->done.store(true, std::memory_order_release);
+    const auto value = uint64_t(1);
+    for(const auto waiter : job->waiters) {
+        ASSERT(write(waiter, &value, sizeof(value)) == sizeof(value));
+    }
+}
+} // namespace
+
+auto XKBKeyboard::deliver(const PendingKey& key) -> void {
+    if(key.is_modifiers) {
+        xkb_state_update_mask(state.get(), key.mods_depressed, key.mods_latched, key.mods_locked, 0, 0, key.group);
+        callbacks->on_xkb_modifiers(state.get());
+        return;
+    }
+    // evdev scancodes are offset by 8 in xkb
+    const auto code = key.key + 8;
+    const auto sym  = xkb_state_key_get_one_sym(state.get(), code);
+    char       utf8[64];
+    xkb_state_key_get_utf8(state.get(), code, utf8, sizeof(utf8));
+    const auto repeated = key.state == key_state_repeated;
+    callbacks->on_xkb_key(key.key, sym, utf8, repeated || key.state == WL_KEYBOARD_KEY_STATE_PRESSED, repeated);
+}
+
+auto XKBKeyboard::set_job(std::shared_ptr<impl::XKBKeymapJob> new_job) -> void {
+    drop_job();
+    job             = std::move(new_job);
+    const auto lock = std::lock_guard(job->lock);
+    if(!job->done.load(std::memory_order_relaxed)) {
+        job->waiters.push_back(fd);
+    }
+}
+
+auto XKBKeyboard::drop_job() -> void {
+    if(job == nullptr) {
+        return;
+    }
+    {
+        const auto lock = std::lock_guard(job->lock);
+        std::erase(job->waiters, fd);
+    }
+    job.reset();
+}
+
+// the fd is closed here, unlike with plain KeyboardCallbacks
+auto XKBKeyboard::on_wl_keyboard_keymap(const uint32_t format, const int32_t fd, const uint32_t size) -> void {
+    // events after a keymap event refer to the new keymap
+    state.reset();
+    keymap.reset();
+    drop_job();
+    pending.clear();
+
+    if(format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1) {
+        close(fd);
+        return;
+    }
+    const auto map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+    const auto data = static_cast<const char*>(map);
+    const auto text = std::string_view(data, strnlen(data, size));
+
+    auto& cache = get_cache();
+    auto  lock  = std::unique_lock(cache.lock);
+    if(const auto entry = cache.jobs.find(text); entry != cache.jobs.end()) {
+        // compiled or being compiled for another keyboard
+        const auto found = entry->second;
+        lock.unlock();
+        munmap(map, size);
+        close(fd);
+        set_job(found);
+        poll();
+        return;
+    }
+    // the cache keeps its own copy of the text for comparison, the worker compiles straight from the mapping
+    const auto entry = std::make_shared<impl::XKBKeymapJob>();
+    cache.jobs.emplace(text, entry);
+    lock.unlock();
+    set_job(entry);
+    std::thread(compile_keymap, entry, map, size_t(size), text, fd).detach();
+}
+
+auto XKBKeyboard::on_wl_keyboard_enter(wl_surface* const surface, const Array<uint32_t>& /*keys*/) -> void {
+    poll();
+    callbacks->on_xkb_enter(surface);
+}
+
+auto XKBKeyboard::on_wl_keyboard_leave(wl_surface* const surface) -> void {
+    poll();
+    callbacks->on_xkb_leave(surface);
+}
+
+auto XKBKeyboard::on_wl_keyboard_key(const uint32_t key, const uint32_t state) -> void {
+    const auto event = PendingKey{.key = key, .state = state, .mods_depressed = 0, .mods_latched = 0, .mods_locked = 0, .group = 0, .is_modifiers = false};
+    if(poll()) {
+        deliver(event);
+    } else if(job != nullptr) {
+        pending.push_back(event);
+    }
+}
+
+auto XKBKeyboard::on_wl_keyboard_modifiers(const uint32_t mods_depressed, const uint32_t mods_latched, const uint32_t mods_locked, const uint32_t group) -> void {
+    const auto event = PendingKey{.key = 0, .state = 0, .mods_depressed = mods_depressed, .mods_latched = mods_latched, .mods_locked = mods_locked, .group = group, .is_modifiers = true};
+    if(poll()) {
+        deliver(event);
+    } else if(job != nullptr) {
+        pending.push_back(event);
+    }
+}
+
+auto XKBKeyboard::on_wl_keyboard_repeat_info(const int32_t rate, const int32_t delay) -> void {
+    callbacks->on_xkb_repeat_info(rate, delay);
+}
+
+auto XKBKeyboard::poll() -> bool {
+    if(job == nullptr || !job->done.load(std::memory_order_acquire)) {
+        return state != nullptr;
+    }
+    // nothing is written if the job was already done when this keyboard started waiting
+    if(auto value = uint64_t(); read(fd, &value, sizeof(value)) != sizeof(value)) {
+        ASSERT(errno == EAGAIN);
+    }
+
+    keymap = job->keymap;
+    if(keymap == nullptr) {
+        // let the next keyboard with this keymap try again
+        auto&      cache = get_cache();
+        const auto lock  = std::lock_guard(cache.lock);
+        std::erase_if(cache.jobs, [this](const auto& entry) { return entry.second == job; });
+    }
+    drop_job();
+    if(keymap == nullptr) {
+        pending.clear();
+        return false;
+    }
+    state.reset(xkb_state_new(keymap.get()));
+    if(state == nullptr) {
+        pending.clear();
+        return false;
+    }
+    callbacks->on_xkb_keymap_ready();
+    for(const auto& event : std::exchange(pending, {})) {
+        deliver(event);
+    }
+    return true;
+}
+
+auto XKBKeyboard::is_ready() const -> bool {
+    return state != nullptr;
+}
+
+auto XKBKeyboard::get_state() -> xkb_state* {
+    return state.get();
+}
+
+auto XKBKeyboard::get_fd() const -> int {
+    return fd;
+}
+
+XKBKeyboard::XKBKeyboard(XKBKeyboardCallbacks* const callbacks)
+    : callbacks(callbacks),
+      fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+XKBKeyboard::~XKBKeyboard() {
+    drop_job();
+    if(fd >= 0) {
+        close(fd);
+    }
+}
+} // namespace towl
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <xkbcommon/xkbcommon.h>
+
+#include "keyboard.hpp"
+#include "macros/autoptr.hpp"
+
+namespace towl::impl {
+declare_autoptr(XKBState, xkb_state, xkb_state_unref);
+
+// compilation result shared by every keyboard that received the same keymap
+struct XKBKeymapJob {
+    std::shared_ptr<xkb_keymap> keymap; // null on failure
+    std::atomic_bool            done = false;
+    std::mutex                  lock;
+    std::vector<int>            waiters; // eventfds written once done, guarded by lock
+};
+} // namespace towl::impl
+
+namespace towl {
+class XKBKeyboardCallbacks {
+  public:
+    // keys received before the keymap was compiled are delivered right after this
+    virtual auto on_xkb_keymap_ready() -> void {}
+    virtual auto on_xkb_enter(wl_surface* /*surface*/) -> void {}
+    virtual auto on_xkb_leave(wl_surface* /*surface*/) -> void {}
+    // utf8 is empty if the key produces no text
+    // repeated keys are also pressed, they are only sent by compositors doing key repeat themselves (wl_seat version 10)
+    virtual auto on_xkb_key(uint32_t /*key*/, xkb_keysym_t /*sym*/, const char* /*utf8*/, bool /*pressed*/, bool /*repeated*/) -> void {}
+    virtual auto on_xkb_modifiers(xkb_state* /*state*/) -> void {}
+    virtual auto on_xkb_repeat_info(int32_t /*rate*/, int32_t /*delay*/) -> void {}
+    virtual ~XKBKeyboardCallbacks() {}
+};
+
+// KeyboardCallbacks that decode keys with xkbcommon
+// keymaps are mapped without copying, compiled on a worker thread, and cached by content for the lifetime of the process
+// so that every seat and every reconnection with the same keymap shares a single compilation
+// the cache holds one copy of each distinct keymap text, lookups compare against the mapping directly
+// failed compilations are not cached
+// must be used from the thread dispatching the keyboard
+class XKBKeyboard : public KeyboardCallbacks {
+  private:
+    struct PendingKey {
+        uint32_t key;
+        uint32_t state;
+        uint32_t mods_depressed;
+        uint32_t mods_latched;
+        uint32_t mods_locked;
+        uint32_t group;
+        bool     is_modifiers;
+    };
+
+    XKBKeyboardCallbacks*               callbacks;
+    std::shared_ptr<xkb_keymap>         keymap;
+    impl::AutoXKBState                  state;
+    std::shared_ptr<impl::XKBKeymapJob> job;
+    std::vector<PendingKey>             pending;
+    int                                 fd = -1; // eventfd
+
+    auto deliver(const PendingKey& key) -> void;
+    auto set_job(std::shared_ptr<impl::XKBKeymapJob> new_job) -> void;
+    auto drop_job() -> void;
+
+  public:
+    auto on_wl_keyboard_keymap(uint32_t format, int32_t fd, uint32_t size) -> void override;
+    auto on_wl_keyboard_enter(wl_surface* surface, const Array<uint32_t>& keys) -> void override;
+    auto on_wl_keyboard_leave(wl_surface* surface) -> void override;
+    auto on_wl_keyboard_key(uint32_t key, uint32_t state) -> void override;
+    auto on_wl_keyboard_modifiers(uint32_t mods_depressed, uint32_t mods_latched, uint32_t mods_locked, uint32_t group) -> void override;
+    auto on_wl_keyboard_repeat_info(int32_t rate, int32_t delay) -> void override;
+
+    // installs the keymap once its compilation finished and delivers the queued keys
+    // also done on every keyboard event, call this from the event loop when get_fd() gets readable to avoid waiting for the next one
+    // returns true if a keymap is ready
+    auto poll() -> bool;
+    auto is_ready() const -> bool;
+    auto get_state() -> xkb_state*; // nullable
+    // readable when a compilation this keyboard waits for finished, cleared by poll()
+    auto get_fd() const -> int;
+
+    XKBKeyboard(XKBKeyboardCallbacks* callbacks);
+    XKBKeyboard(XKBKeyboard&) = delete;
+    ~XKBKeyboard();
+};
+} // namespace towl